@@ -0,0 +1,180 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/25/25.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "zelix/cli/app.h"
+
+using namespace zelix;
+
+/*
+ * Parse latency under adversarial command lines.
+ *
+ * Every case is parsed repeatedly against a 900-flag schema, and the
+ * median, 99th percentile and worst parse are reported. With limits
+ * set, oversized lines are rejected before any lookup, so their tail
+ * stays as flat as that of ordinary ones; the last rows parse the same
+ * lines without limits for comparison.
+ */
+namespace
+{
+    constexpr size_t FLAGS = 900;
+    constexpr size_t TOKEN_LENGTH = 4096;
+    const char *no_args[] = {"tool", nullptr};
+
+    class command_line
+    {
+        std::vector<std::string> storage;
+
+    public:
+        std::vector<const char *> argv;
+
+        explicit command_line(std::vector<std::string> tokens) :
+            storage(std::move(tokens))
+        {
+            argv.push_back("tool");
+            argv.push_back("run");
+            for (const auto &token : storage)
+            {
+                argv.push_back(token.c_str());
+            }
+
+            argv.push_back(nullptr);
+        }
+
+        [[nodiscard]] int argc() const
+        {
+            return static_cast<int>(argv.size() - 1);
+        }
+    };
+
+    /**
+     * @brief Registers the flags, whose names must outlive the app.
+     */
+    void setup(cli::app &app, const std::vector<std::string> &names, const std::vector<std::string> &aliases)
+    {
+        app.command("run", "r", "Runs", false);
+        app.positional("inputs", "Files", true);
+
+        for (size_t i = 0; i < FLAGS; ++i)
+        {
+            app.flag(names[i].c_str(), aliases[i].c_str(), "A flag", Celery::Str::External(""));
+        }
+    }
+
+    void run(cli::app &app, const char *label, const command_line &line, const size_t rounds)
+    {
+        std::vector<double> times;
+        times.reserve(rounds);
+
+        for (size_t i = 0; i < rounds; ++i)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            const auto args = app.parse(line.argc(), const_cast<const char **>(line.argv.data()));
+            const auto end = std::chrono::steady_clock::now();
+
+            times.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+        }
+
+        std::sort(times.begin(), times.end());
+        printf(
+            "%-32s %10.2f %10.2f %10.2f  %s\n",
+            label,
+            times[times.size() / 2],
+            times[times.size() * 99 / 100],
+            times.back(),
+            cli::args::is_err() ? "rejected" : "parsed"
+        );
+    }
+
+    std::vector<std::string> known_flags(const size_t count)
+    {
+        std::vector<std::string> tokens;
+        for (size_t i = 0; i < count; ++i)
+        {
+            tokens.push_back("--flag-" + std::to_string(i * 29 % FLAGS) + "=value");
+        }
+
+        return tokens;
+    }
+}
+
+int main()
+{
+    std::vector<std::string> names;
+    std::vector<std::string> aliases;
+    for (size_t i = 0; i < FLAGS; ++i)
+    {
+        names.push_back("flag-" + std::to_string(i));
+        aliases.push_back("f" + std::to_string(i));
+    }
+
+    cli::app limited("tool", "Adversarial inputs", 1, no_args);
+    setup(limited, names, aliases);
+    limited.limit({.tokens = 256, .token_length = TOKEN_LENGTH, .total_bytes = 1 << 16});
+
+    cli::app unlimited("tool", "Adversarial inputs", 1, no_args);
+    setup(unlimited, names, aliases);
+
+#ifdef ZELIX_CLI_SEEDED_HASH
+    printf("Hash: seeded SipHash-1-3\n");
+#else
+    printf("Hash: fixed\n");
+#endif
+    printf("%-32s %10s %10s %10s  %s\n", "Case (us per parse)", "p50", "p99", "max", "result");
+
+    // Ordinary input, the baseline
+    run(limited, "32 known flags", command_line(known_flags(32)), 20000);
+
+    // Names one character away from registered ones, only told apart by the final compare
+    std::vector<std::string> near_misses = known_flags(31);
+    near_misses.push_back("--flag-" + std::to_string(FLAGS - 1) + "x");
+    run(limited, "31 known flags, 1 near miss", command_line(near_misses), 20000);
+
+    // Unknown names as long as the limit allows
+    std::vector<std::string> long_unknown = known_flags(31);
+    long_unknown.push_back("--" + std::string(TOKEN_LENGTH - 2, 'z'));
+    run(limited, "31 known flags, 1 long unknown", command_line(long_unknown), 20000);
+
+    // The most input the limits let through
+    std::vector<std::string> full(15, std::string(TOKEN_LENGTH, 'v'));
+    run(limited, "15 tokens at the length limit", command_line(full), 20000);
+
+    // Oversized input, rejected before any lookup
+    const command_line huge_token({std::string(16 << 20, 'x')});
+    const command_line many_tokens(std::vector<std::string>(1 << 20, "a"));
+    run(limited, "16 MiB token, limited", huge_token, 20000);
+    run(limited, "1M tokens, limited", many_tokens, 20000);
+    run(unlimited, "16 MiB token, unlimited", huge_token, 50);
+    run(unlimited, "1M tokens, unlimited", many_tokens, 50);
+    return 0;
+}
@@ -29,15 +29,20 @@
 
 #pragma once
 
-#include <ankerl/unordered_dense.h>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <vector>
 #include "celery/misc/ansi.h"
-#include "celery/misc/hash.h"
 #include "args.h"
+#include "cache.h"
+#include "frozen.h"
+#include "reader.h"
 #include "celery/string/external.h"
 #include "celery/string/string.h"
 #include "celery/except/base.h"
+#include "schema.h"
 #include "value.h"
-#include <celery/misc/string_equal.h>
 
 namespace zelix::cli
 {
@@ -46,63 +51,87 @@ namespace zelix::cli
         const char *name_ = nullptr;
         const char *desc_ = nullptr;
 
-        ankerl::unordered_dense::map<
-            Celery::Str::External,
-            value,
-            Celery::Misc::Hash,
-			Celery::Misc::StringEquality
-        > commands;
-
-        ankerl::unordered_dense::map<
-            Celery::Str::External,
-            value,
-            Celery::Misc::Hash,
-			Celery::Misc::StringEquality
-        > flags;
-
-        // Aliases (cmd name -> alias)
-        ankerl::unordered_dense::map<
-            Celery::Str::External,
-            Celery::Str::External,
-            Celery::Misc::Hash,
-			Celery::Misc::StringEquality
-        > cmd_aliases;
-
-        ankerl::unordered_dense::map<
-            Celery::Str::External,
-            Celery::Str::External,
-            Celery::Misc::Hash,
-			Celery::Misc::StringEquality
-        > flag_aliases;
-
-        // Aliases (alias -> cmd name)
-        ankerl::unordered_dense::map<
-            Celery::Str::External,
-            Celery::Str::External,
-            Celery::Misc::Hash,
-			Celery::Misc::StringEquality
-        > cmd_aliases_reverse;
-
-        ankerl::unordered_dense::map<
-            Celery::Str::External,
-            Celery::Str::External,
-            Celery::Misc::Hash,
-			Celery::Misc::StringEquality
-        > flag_aliases_reverse;
-
-        const int argc;
+        schema schema_; ///< Everything registered in the app
+        const schema_image *image_ = nullptr; ///< Frozen schema the app was built from, if any
+
+        int argc;
         const char **argv;
 
+        void check_mutable() const
+        {
+            if (image_ != nullptr)
+            {
+                throw Celery::Except::Exception("Apps built from a frozen schema are read-only");
+            }
+        }
+
+        size_t add_slot(
+            value val,
+            const Celery::Str::External &name,
+            const Celery::Str::External &alias,
+            const bool command
+        )
+        {
+            const size_t slot = schema_.slots++;
+            val.set_slot(slot);
+            schema_.values.push_back(std::move(val));
+            schema_.slot_names.push_back(name);
+            schema_.slot_aliases.push_back(alias);
+            schema_.slot_envs.emplace_back();
+            schema_.owners.push_back(schema_.loading);
+
+            if (command)
+            {
+                schema_.command_slots.set(slot);
+            }
+
+            return slot;
+        }
+
+        void bind(const size_t slot, const binding &dest)
+        {
+            if (slot >= schema_.bindings.size())
+            {
+                schema_.bindings.resize(schema_.slots);
+            }
+
+            schema_.bindings[slot] = dest;
+        }
+
+        void check_slot(const size_t slot) const
+        {
+            if (slot >= schema_.slots)
+            {
+                throw Celery::Except::OutOfRange();
+            }
+        }
+
+        static void write_choices(
+            Celery::Str::String &msg,
+            const choice_set &set,
+            const char separator
+        )
+        {
+            for (size_t i = 0; i < set.size(); ++i)
+            {
+                if (i != 0)
+                {
+                    msg.Write(separator);
+                }
+
+                msg.Write(set[i].Ptr(), set[i].Size());
+            }
+        }
+
         void write_val_info(
             Celery::Str::String &msg,
             const Celery::Str::External &name,
             const value &val,
-            const bool flag,
             const int alias_padding = 0
         )
         {
             const auto &desc = val.get_description();
-            const auto &alias = flag ? flag_aliases[name] : cmd_aliases[name];
+            const auto &alias = schema_.slot_aliases[val.get_slot()];
 
             msg.Write(Celery::Misc::Ansi::Reset, 4);
             msg.Write(Celery::Misc::Ansi::Bright::Black, 5);
@@ -115,51 +144,134 @@ namespace zelix::cli
                 msg.Write(' ');
             }
 
-            switch (val.get_type())
+            const auto &ops = val.get_ops();
+            msg.Write("[type=", 6);
+            ops.describe(val.get_default(), msg);
+            msg.Write(", default=", 10);
+            ops.format(schema_.default_of(val), msg);
+
+            if (schema_.required.test(val.get_slot()))
+            {
+                msg.Write(", required", 10);
+            }
+
+            if (const auto &env = schema_.slot_envs[val.get_slot()]; env.Size() != 0)
+            {
+                msg.Write(", env=", 6);
+                msg.Write(env.Ptr(), env.Size());
+            }
+
+            msg.Write(']');
+            msg.Write(Celery::Misc::Ansi::Reset, 4);
+            msg.Write('\n');
+        }
+
+        template <bool Unicode>
+        void write_listing(Celery::Str::String &msg)
+        {
+            if (!schema_.command_slots.empty())
+            {
+                msg.Write(Celery::Misc::Ansi::Yellow, 5);
+                msg.Write(
+                    "Available commands:\n",
+                    20
+                );
+                msg.Write(Celery::Misc::Ansi::Reset, 4);
+            }
+
+            for (size_t slot = 0; slot < schema_.slots; ++slot)
             {
-                case value::STRING:
+                if (!schema_.command_slots.test(slot))
                 {
-                    msg.Write("[type=str, default=", 19);
-                    const auto str_val = val.get<Celery::Str::External>();
-                    msg.Write(str_val.Ptr(), str_val.Size());
-                    break;
+                    continue;
                 }
 
-                case value::BOOL:
+                const auto &name = schema_.slot_names[slot];
+                msg.Write(Celery::Misc::Ansi::Bright::Black, 5);
+                msg.Write("  ", 2);
+                if constexpr (Unicode)
                 {
-                    msg.Write("[type=bool, default=", 20);
-                    if (val.get<bool>())
-                    {
-                        msg.Write("true", 4);
-                    }
-                    else
-                    {
-                        msg.Write("false", 5);
-                    }
-
-                    break;
+                    msg.Write("➤ ");
                 }
-
-                case value::FLOAT:
+                else
                 {
-                    msg.Write("[type=float, default=", 21);
-                    const std::string float_str = std::to_string(val.get<float>());
-                    msg.Write(float_str.c_str(), float_str.size());
-                    break;
+                    msg.Write("> ", 2);
                 }
+                msg.Write(Celery::Misc::Ansi::Reset, 4);
+                msg.Write(Celery::Misc::Ansi::Cyan, 5);
+                msg.Write(name.Ptr(), name.Size());
+
+                // Honor aliases
+                const auto &alias = schema_.slot_aliases[slot];
+                msg.Write(", ", 2);
+                msg.Write(alias.Ptr(), alias.Size());
 
-                case value::INTEGER:
+                // Write the value's info
+                write_val_info(msg, name, schema_.values[slot]);
+            }
+
+            if (!schema_.positionals.empty())
+            {
+                msg.Write(Celery::Misc::Ansi::Yellow, 5);
+                msg.Write(
+                    "Positional arguments:\n",
+                    22
+                );
+                msg.Write(Celery::Misc::Ansi::Reset, 4);
+            }
+
+            for (const auto &pos : schema_.positionals)
+            {
+                msg.Write("  ", 2);
+                msg.Write(Celery::Misc::Ansi::Bright::Yellow, 5);
+                msg.Write('<');
+                msg.Write(pos.name.Ptr(), pos.name.Size());
+                msg.Write('>');
+
+                if (pos.variadic)
                 {
-                    msg.Write("[type=int, default=", 19);
-                    const std::string int_str = std::to_string(val.get<int>());
-                    msg.Write(int_str.c_str(), int_str.size());
-                    break;
+                    msg.Write("...", 3);
                 }
+
+                msg.Write(Celery::Misc::Ansi::Reset, 4);
+                msg.Write(Celery::Misc::Ansi::Bright::Black, 5);
+                msg.Write(" ~ ", 3);
+                msg.Write(pos.description.Ptr(), pos.description.Size());
+                msg.Write(Celery::Misc::Ansi::Reset, 4);
+                msg.Write('\n');
             }
 
-            msg.Write(']');
-            msg.Write(Celery::Misc::Ansi::Reset, 4);
-            msg.Write('\n');
+            // Every slot that is not a command holds a flag
+            if (schema_.slots > schema_.command_slots.count_common(schema_.command_slots))
+            {
+                msg.Write(Celery::Misc::Ansi::Yellow, 5);
+                msg.Write(
+                    "Available flags:\n",
+                    17
+                );
+                msg.Write(Celery::Misc::Ansi::Reset, 4);
+            }
+
+            for (size_t slot = 0; slot < schema_.slots; ++slot)
+            {
+                if (schema_.command_slots.test(slot))
+                {
+                    continue;
+                }
+
+                const auto &name = schema_.slot_names[slot];
+                msg.Write("  ", 2);
+                msg.Write(Celery::Misc::Ansi::Bright::Blue, 5);
+                msg.Write("--", 2);
+                msg.Write(name.Ptr(), name.Size());
+
+                // Honor aliases
+                const auto &alias = schema_.slot_aliases[slot];
+                msg.Write(", -", 3);
+                msg.Write(alias.Ptr(), alias.Size());
+
+                write_val_info(msg, name, schema_.values[slot], 1);
+            }
         }
     public:
         explicit app(
@@ -176,6 +288,26 @@ namespace zelix::cli
             }
         }
 
+        /**
+         * @brief Constructs a read-only app from a frozen schema.
+         *
+         * Names are looked up through the hash tables stored in the
+         * image, and names, descriptions and the help listing are read
+         * from it directly; only the values of each slot are copied.
+         * No command, flag or positional can be added.
+         *
+         * @param image The frozen schema, which must outlive the app.
+         */
+        explicit app(
+            const schema_image &image,
+            const int argc,
+            const char **argv
+        )
+            : name_(image.name()), desc_(image.description()), image_(&image), argc(argc), argv(argv)
+        {
+            image.thaw(schema_);
+        }
+
         [[nodiscard]] const char *name() const
         {
             return name_;
@@ -186,33 +318,40 @@ namespace zelix::cli
             return desc_;
         }
 
+        /**
+         * @brief Registers a command.
+         * @return The slot of the command, as reported by `reader` events.
+         */
         template <typename T>
-        void command(
+        size_t command(
             const Celery::Str::External &name,
             const Celery::Str::External &alias,
             const Celery::Str::External &description,
             const T &def
         )
         {
-            if (commands.contains(name) || cmd_aliases_reverse.contains(alias))
+            check_mutable();
+            if (schema_.command_ids.contains(name) || schema_.command_alias_ids.contains(alias))
             {
                 throw Celery::Except::Exception("Command already exists");
             }
 
-            cmd_aliases[name] = alias;
-            cmd_aliases_reverse[alias] = name;
-            commands[name] = value(def, description);
+            const size_t slot = add_slot(value(def, description), name, alias, true);
+            schema_.command_ids[name] = slot;
+            schema_.command_alias_ids[alias] = slot;
+            schema_.provide(slot, def);
+            return slot;
         }
 
         template <typename T>
-        void command(
+        size_t command(
             const char *name,
             const char *alias,
             const char *description,
             const T &value
         )
         {
-            command(
+            return command(
                 Celery::Str::External(name, strlen(name)),
                 Celery::Str::External(alias, strlen(alias)),
                 Celery::Str::External(description, strlen(description)),
@@ -220,33 +359,100 @@ namespace zelix::cli
             );
         }
 
+        /**
+         * @brief Registers a command whose flags are registered on demand.
+         *
+         * `flags` is called with this app the first time the command is
+         * selected, before the rest of the command line is read, so only
+         * the selected command's flags are ever registered. Those flags
+         * must come after the command, and are rejected under any other
+         * command. The app must not be moved afterwards.
+         *
+         * @param flags Registers the command's flags.
+         */
         template <typename T>
-        void flag(
+        size_t command(
+            const Celery::Str::External &name,
+            const Celery::Str::External &alias,
+            const Celery::Str::External &description,
+            const T &def,
+            std::function<void(app &)> flags
+        )
+        {
+            const size_t slot = command(name, alias, description, def);
+            schema_.registrars[name] = [this, flags = std::move(flags)]
+            {
+                flags(*this);
+            };
+
+            return slot;
+        }
+
+        template <typename T>
+        size_t command(
+            const char *name,
+            const char *alias,
+            const char *description,
+            const T &value,
+            std::function<void(app &)> flags
+        )
+        {
+            return command(
+                Celery::Str::External(name, strlen(name)),
+                Celery::Str::External(alias, strlen(alias)),
+                Celery::Str::External(description, strlen(description)),
+                value,
+                std::move(flags)
+            );
+        }
+
+        /**
+         * @brief Registers the flags of a command ahead of time.
+         *
+         * `parse()` and `from_bytes()` do this by themselves. It is only
+         * needed to use the command's flags with `events()`.
+         *
+         * @param command The name of the command.
+         */
+        void load(const char *command)
+        {
+            schema_.load(Celery::Str::External(command));
+        }
+
+        /**
+         * @brief Registers a flag.
+         * @return The slot of the flag, as reported by `reader` events.
+         */
+        template <typename T>
+        size_t flag(
             const Celery::Str::External &name,
             const Celery::Str::External &alias,
             const Celery::Str::External &description,
             const T &def
         )
         {
-            if (flags.contains(name) || flag_aliases_reverse.contains(alias))
+            check_mutable();
+            if (schema_.flag_ids.contains(name) || schema_.flag_alias_ids.contains(alias))
             {
                 throw Celery::Except::Exception("Flag already exists");
             }
 
-            flag_aliases[name] = alias;
-            flag_aliases_reverse[alias] = name;
-            flags[name] = value(def, description);
+            const size_t slot = add_slot(value(def, description), name, alias, false);
+            schema_.flag_ids[name] = slot;
+            schema_.flag_alias_ids[alias] = slot;
+            schema_.provide(slot, def);
+            return slot;
         }
 
         template <typename T>
-        void flag(
+        size_t flag(
             const char *name,
             const char *alias,
             const char *description,
             const T &value
         )
         {
-            flag(
+            return flag(
                 Celery::Str::External(name, strlen(name)),
                 Celery::Str::External(alias, strlen(alias)),
                 Celery::Str::External(description, strlen(description)),
@@ -254,21 +460,574 @@ namespace zelix::cli
             );
         }
 
-        args parse()
+        /**
+         * @brief Registers a flag that falls back to an environment variable.
+         *
+         * When the flag is not given in the command line, its value is
+         * taken from the environment variable, and only if that is not
+         * defined either, from the default value.
+         *
+         * @param env The name of the environment variable.
+         */
+        template <typename T>
+        size_t flag(
+            const Celery::Str::External &name,
+            const Celery::Str::External &alias,
+            const Celery::Str::External &description,
+            const T &def,
+            const Celery::Str::External &env
+        )
+        {
+            const size_t slot = flag(name, alias, description, def);
+            schema_.slot_envs[slot] = env;
+            schema_.env_slots.push_back(slot);
+            return slot;
+        }
+
+        template <typename T>
+        size_t flag(
+            const char *name,
+            const char *alias,
+            const char *description,
+            const T &value,
+            const char *env
+        )
+        {
+            return flag(
+                Celery::Str::External(name, strlen(name)),
+                Celery::Str::External(alias, strlen(alias)),
+                Celery::Str::External(description, strlen(description)),
+                value,
+                Celery::Str::External(env, strlen(env))
+            );
+        }
+
+        /**
+         * @brief Registers a flag that is written straight into a variable.
+         *
+         * The value, or the default when the flag is not given, is stored
+         * in `*dest` during `parse()` and never reaches `args`; read it
+         * from the variable instead.
+         *
+         * `const char *` variables set from the configuration file point
+         * to a copy owned by the returned `args`.
+         *
+         * @param dest The variable to write into. Must outlive every parse.
+         */
+        template <typename T>
+        size_t flag(
+            const Celery::Str::External &name,
+            const Celery::Str::External &alias,
+            const Celery::Str::External &description,
+            const std::type_identity_t<T> &def,
+            T *dest
+        )
+        {
+            if (dest == nullptr)
+            {
+                throw Celery::Except::Exception("Destination cannot be null");
+            }
+
+            const size_t slot = flag(name, alias, description, def);
+            bind(slot, binding::variable(dest));
+            return slot;
+        }
+
+        template <typename T>
+        size_t flag(
+            const char *name,
+            const char *alias,
+            const char *description,
+            const std::type_identity_t<T> &value,
+            T *dest
+        )
+        {
+            return flag(
+                Celery::Str::External(name, strlen(name)),
+                Celery::Str::External(alias, strlen(alias)),
+                Celery::Str::External(description, strlen(description)),
+                value,
+                dest
+            );
+        }
+
+        /**
+         * @brief Registers a flag that is written straight into a struct member.
+         *
+         * Works like binding a variable, except the object is given to
+         * `parse()`, so the same app can fill many objects. Every member
+         * binding of an app must belong to the same class.
+         *
+         * @tparam Member The member to write into, e.g. `&config::jobs`.
+         */
+        template <auto Member>
+        size_t flag(
+            const Celery::Str::External &name,
+            const Celery::Str::External &alias,
+            const Celery::Str::External &description,
+            const binding::field_of<decltype(Member)> &def
+        )
+        {
+            const auto owner = binding::tag<binding::owner_of<decltype(Member)>>();
+            if (schema_.bound_type != nullptr && schema_.bound_type != owner)
+            {
+                throw Celery::Except::Exception("Members must belong to the same class");
+            }
+
+            const size_t slot = flag(name, alias, description, def);
+            schema_.bound_type = owner;
+            bind(slot, binding::member<Member>());
+            return slot;
+        }
+
+        template <auto Member>
+        size_t flag(
+            const char *name,
+            const char *alias,
+            const char *description,
+            const binding::field_of<decltype(Member)> &value
+        )
+        {
+            return flag<Member>(
+                Celery::Str::External(name, strlen(name)),
+                Celery::Str::External(alias, strlen(alias)),
+                Celery::Str::External(description, strlen(description)),
+                value
+            );
+        }
+
+        /**
+         * @brief Registers a positional argument.
+         *
+         * Positionals are filled in declaration order from the
+         * arguments that follow the command (and its value). Only
+         * the last positional may be variadic, in which case it
+         * takes every remaining contiguous argument. Its arguments
+         * are handed out as a single view over argv, so flags may
+         * come before or after them but not in between:
+         * `cmd -v a b` and `cmd a b -v` work, `cmd a -v b` fails
+         * with `SPLIT_VARIADIC`.
+         *
+         * @param name The name of the positional.
+         * @param description The description of the positional.
+         * @param variadic Whether the positional takes every remaining argument.
+         * @return The index of the positional, as reported by `reader` events.
+         */
+        size_t positional(
+            const Celery::Str::External &name,
+            const Celery::Str::External &description,
+            const bool variadic = false
+        )
+        {
+            check_mutable();
+            if (schema_.positional_ids.contains(name))
+            {
+                throw Celery::Except::Exception("Positional already exists");
+            }
+
+            if (!schema_.positionals.empty() && schema_.positionals.back().variadic)
+            {
+                throw Celery::Except::Exception("Only the last positional can be variadic");
+            }
+
+            schema_.positional_ids[name] = schema_.positionals.size();
+            schema_.positionals.push_back(positional_spec{name, description, variadic});
+            return schema_.positionals.size() - 1;
+        }
+
+        size_t positional(
+            const char *name,
+            const char *description,
+            const bool variadic = false
+        )
         {
-            args parsed_args(
-                commands,
-                flags,
-                cmd_aliases,
-                flag_aliases,
-                cmd_aliases_reverse,
-                flag_aliases_reverse
+            return positional(
+                Celery::Str::External(name, strlen(name)),
+                Celery::Str::External(description, strlen(description)),
+                variadic
             );
+        }
+
+        /**
+         * @brief Gets the slot of a registered flag or command.
+         *
+         * Flags are looked up first.
+         */
+        [[nodiscard]] size_t slot_of(const Celery::Str::External &name) const
+        {
+            if (const size_t slot = schema_.find_flag(name); slot != schema::NONE)
+            {
+                return slot;
+            }
+
+            return schema_.command(name).get_slot();
+        }
+
+        [[nodiscard]] size_t slot_of(const char *name) const
+        {
+            return slot_of(Celery::Str::External(name));
+        }
+
+        /**
+         * @brief Makes a command or flag mandatory.
+         *
+         * Values coming from the environment or a configuration file
+         * count as given. Flags registered by a command's registrar
+         * stay registered once it has run, but are only required
+         * when that command is selected. Exclusive groups and
+         * dependencies only trigger on flags that were given, so
+         * those of other commands never trigger them either.
+         *
+         * @param slot The slot, as returned by `command()`, `flag()` or `slot_of()`.
+         */
+        void require(const size_t slot)
+        {
+            check_slot(slot);
+            schema_.required.set(slot);
+        }
+
+        /**
+         * @brief Makes a group of commands and flags mutually exclusive.
+         * @param slots The slots in the group.
+         */
+        void exclusive(const std::initializer_list<size_t> slots)
+        {
+            slot_set group;
+            for (const auto slot : slots)
+            {
+                check_slot(slot);
+                group.set(slot);
+            }
+
+            schema_.exclusive_groups.push_back(group);
+        }
+
+        /**
+         * @brief Makes a command or flag require others.
+         * @param slot The dependent slot.
+         * @param needs The slots that must be given along with it.
+         */
+        void depends(const size_t slot, const std::initializer_list<size_t> needs)
+        {
+            check_slot(slot);
+
+            dependency dep;
+            dep.slot = slot;
+            for (const auto need : needs)
+            {
+                check_slot(need);
+                dep.needs.set(need);
+            }
+
+            schema_.dependencies.push_back(dep);
+        }
+
+        /**
+         * @brief Checks that the values of a flag, command or positional are paths to something.
+         *
+         * The check runs after parsing, for every value given in argv,
+         * the environment or the configuration file (defaults are not
+         * checked), with all paths queried in one concurrent batch.
+         * The value must be a string or a `cli::path`.
+         *
+         * ```c++
+         * app.flag("out", "o", "output directory", cli::path("."));
+         * app.positional("inputs", "files to process", true);
+         * app.check_path("out", cli::path_check::DIRECTORY);
+         * app.check_path("inputs", cli::path_check::FILE);
+         * ```
+         *
+         * @param name The name of the flag, command or positional.
+         * @param check What the paths must point to.
+         */
+        void check_path(const Celery::Str::External &name, const path_check::type check)
+        {
+            if (const size_t pos = schema_.find_positional(name); pos != schema::NONE)
+            {
+                schema_.positional_paths.resize(schema_.positionals.size(), path_check::NONE);
+                schema_.positional_paths[pos] = check;
+                return;
+            }
+
+            const size_t flag = schema_.find_flag(name);
+            const auto &val = flag != schema::NONE ? schema_.values[flag] : schema_.command(name);
+
+            if (val.get_type() != value::STRING && &val.get_ops() != ops_of<path>())
+            {
+                throw Celery::Except::Exception("Only strings and paths can be checked");
+            }
+
+            schema_.slot_paths.resize(schema_.slots, path_check::NONE);
+            schema_.slot_paths[val.get_slot()] = check;
+        }
+
+        void check_path(const char *name, const path_check::type check)
+        {
+            check_path(Celery::Str::External(name), check);
+        }
+
+        /**
+         * @brief Rejects string values and positionals that are not valid UTF-8.
+         *
+         * Values from argv, the environment and the configuration file
+         * are all checked, and the offending byte is reported through
+         * `global_error.offset`.
+         *
+         * @param reject_control Whether control characters are rejected too.
+         */
+        void validate_utf8(const bool reject_control = false)
+        {
+            schema_.check_utf8 = true;
+            schema_.reject_control = reject_control;
+        }
+
+        /**
+         * @brief Bounds the size of the command lines the app accepts.
+         *
+         * Every vector is checked before any name is looked up, so
+         * oversized input from untrusted callers is rejected in time
+         * proportional to the limits, not to the input.
+         *
+         * ```c++
+         * app.limit({.tokens = 256, .token_length = 4096, .total_bytes = 65536});
+         * ```
+         */
+        void limit(const parse_limits &limits)
+        {
+            schema_.limits = limits;
+        }
+
+        /**
+         * @brief Sets the configuration file to read flags from.
+         *
+         * Values given in the command line take precedence over the
+         * environment, which in turn takes precedence over the file.
+         * The file is memory-mapped and only entries matching a
+         * registered flag are ever converted. Entries under a
+         * `[section]` only apply when that command is selected.
+         *
+         * The file is indexed once, here, so parses don't read it again.
+         * Malformed files, e.g. with an unterminated `[section` header,
+         * are rejected with a `MALFORMED_CONFIG` error whose offset is
+         * that of the offending line.
+         *
+         * @param path The path to the file.
+         * @return Whether the file could be read.
+         */
+        bool config(const char *path)
+        {
+            return schema_.config.open(path);
+        }
+
+        /**
+         * @brief Parses the command line.
+         *
+         * In lazy mode, parsing only locates values; each one is
+         * converted the first time it is read (and memoized), and
+         * type errors are reported at that point.
+         *
+         * @tparam Lazy Whether to defer conversions until values are read.
+         */
+        template <bool Lazy = false>
+        args parse()
+        {
+            args parsed_args(schema_, Lazy);
 
             parsed_args.parse(argc, argv);
             return parsed_args;
         }
 
+        /**
+         * @brief Parses the command line into an object.
+         *
+         * Flags registered with `flag<&C::member>()` are written into
+         * `target`; everything else is available in the returned `args`.
+         *
+         * @param target The object to fill.
+         */
+        template <bool Lazy = false, typename C>
+        args parse(C &target)
+        {
+            if (schema_.bound_type != binding::tag<C>())
+            {
+                throw Celery::Except::Exception("Target does not match the bound members");
+            }
+
+            args parsed_args(schema_, Lazy);
+            parsed_args.parse(argc, argv, nullptr, &target);
+            return parsed_args;
+        }
+
+        /**
+         * @brief Rebinds the app to another argument vector, without parsing it.
+         *
+         * `parse()` and `help()` then work on the new vector.
+         */
+        void rebind(const int argc, const char **argv)
+        {
+            this->argc = argc;
+            this->argv = argv;
+        }
+
+        /**
+         * @brief Parses another argument vector against the same schema.
+         *
+         * The app is rebound to the new vector, so `help()` reports
+         * errors against it. Useful for servers that parse many command
+         * lines, e.g. coming from `tokenizer::split()`.
+         *
+         * @param argc The number of arguments.
+         * @param argv The arguments, null-terminated.
+         * @param lens The length of each argument, if already known.
+         */
+        template <bool Lazy = false>
+        args parse(
+            const int argc,
+            const char **argv,
+            const size_t *lens = nullptr
+        )
+        {
+            rebind(argc, argv);
+
+            args parsed_args(schema_, Lazy);
+            parsed_args.parse(argc, argv, lens);
+            return parsed_args;
+        }
+
+        /**
+         * @brief Parses an edited command line, reusing the work done for the previous one.
+         *
+         * The app is rebound to the new vector. Only the tokens from the
+         * first one that differs from the last vector given to `previous`
+         * are read again; see `args::reparse()`.
+         *
+         * ```c++
+         * cli::args line = app.parse();
+         *
+         * // On every keystroke
+         * app.reparse(line, argc, argv);
+         * ```
+         *
+         * @param previous The result to update, made by this app.
+         * @param argc The number of arguments.
+         * @param argv The arguments, null-terminated.
+         * @param lens The length of each argument, if already known.
+         */
+        bool reparse(
+            args &previous,
+            const int argc,
+            const char **argv,
+            const size_t *lens = nullptr
+        )
+        {
+            rebind(argc, argv);
+            return previous.reparse(argc, argv, lens);
+        }
+
+        /**
+         * @brief Parses a command line holding several commands.
+         *
+         * Commands are separated by `delimiter` tokens, e.g.
+         * `tool build --release + test --jobs=8 + package`, and are
+         * all read in a single pass over argv. On failure, the last
+         * element is the command that failed.
+         *
+         * @param delimiter The token between commands.
+         * @return The results of each command, in order.
+         */
+        template <bool Lazy = false>
+        std::vector<args> parse_chain(const char *delimiter = "+")
+        {
+            reader tokens(schema_, argc, argv);
+            tokens.chain(Celery::Str::External(delimiter));
+
+            std::vector<args> chain;
+            do
+            {
+                if (!chain.emplace_back(schema_, Lazy).parse(tokens))
+                {
+                    break;
+                }
+            }
+            while (!tokens.finished());
+
+            return chain;
+        }
+
+        /**
+         * @brief Creates a cache of parse results for this app.
+         *
+         * Throws if any flag is bound to a variable or member; see
+         * `parse_cache`.
+         *
+         * @param capacity The maximum number of results to keep.
+         */
+        [[nodiscard]] parse_cache cache(const size_t capacity)
+        {
+            return parse_cache(schema_, capacity);
+        }
+
+        /**
+         * @brief Serializes the schema into a position-independent buffer.
+         *
+         * Write it to a file or a shared memory segment and load it
+         * through a `schema_image` to build the same app in other
+         * processes without registering anything. Bound flags, custom
+         * value types and on-demand flags can't be frozen.
+         */
+        [[nodiscard]] std::vector<unsigned char> freeze()
+        {
+            Celery::Str::String listing;
+            Celery::Str::String listing_ascii;
+            write_listing<true>(listing);
+            write_listing<false>(listing_ascii);
+
+            return frozen::writer(schema_).finish(name_, desc_, listing.c_str(), listing_ascii.c_str());
+        }
+
+        /**
+         * @brief Reads parse results serialized by another process or thread.
+         *
+         * The producing app must have registered the same commands, flags
+         * and positionals; this is checked through the schema fingerprint.
+         * The selected command's flags are registered here if needed, so
+         * workers don't have to know it in advance; the producer must not
+         * have loaded other commands' flags before it, though, as their
+         * slots would differ.
+         *
+         * @param bytes A buffer made by `args::serialize()`.
+         * @param size The size of the buffer.
+         */
+        [[nodiscard]] args_view from_bytes(const void *bytes, const size_t size)
+        {
+            return args_view::from_bytes(schema_, bytes, size);
+        }
+
+        /**
+         * @brief Creates a pull-based parser over the app's argv.
+         *
+         * Unlike `parse()`, nothing is converted or stored; see `reader`.
+         */
+        [[nodiscard]] reader events() const
+        {
+            return reader(schema_, argc, argv);
+        }
+
+        /**
+         * @brief Creates a pull-based parser over another argument vector.
+         * @param argc The number of arguments.
+         * @param argv The arguments, null-terminated.
+         * @param lens The length of each argument, if already known.
+         */
+        [[nodiscard]] reader events(
+            const int argc,
+            const char **argv,
+            const size_t *lens = nullptr
+        ) const
+        {
+            return reader(schema_, argc, argv, lens);
+        }
+
         template <bool Unicode = true>
         [[nodiscard]] Celery::Str::String help()
         {
@@ -304,6 +1063,57 @@ namespace zelix::cli
                         msg.Write("Type mismatch", 13);
                         break;
 
+                    case error::INVALID_CHOICE:
+                        msg.Write("Invalid choice", 14);
+                        break;
+
+                    case error::MISSING_REQUIRED:
+                        msg.Write("Missing required argument ", 26);
+                        msg.Write(global_error.source.Ptr(), global_error.source.Size());
+                        break;
+
+                    case error::CONFLICTING_ARGUMENTS:
+                        msg.Write("Conflicts with ", 15);
+                        msg.Write(global_error.source.Ptr(), global_error.source.Size());
+                        break;
+
+                    case error::MISSING_DEPENDENCY:
+                        msg.Write("Requires ", 9);
+                        msg.Write(global_error.source.Ptr(), global_error.source.Size());
+                        break;
+
+                    case error::INVALID_UTF8:
+                    {
+                        msg.Write("Invalid UTF-8 at byte ", 22);
+                        const std::string offset_str = std::to_string(global_error.offset);
+                        msg.Write(offset_str.c_str(), offset_str.size());
+                        break;
+                    }
+
+                    case error::CONTROL_CHARACTER:
+                    {
+                        msg.Write("Control character at byte ", 26);
+                        const std::string offset_str = std::to_string(global_error.offset);
+                        msg.Write(offset_str.c_str(), offset_str.size());
+                        break;
+                    }
+
+                    case error::LIMIT_EXCEEDED:
+                        msg.Write("Command line too long", 21);
+                        break;
+
+                    case error::PATH_NOT_FOUND:
+                        msg.Write("No such file or directory", 25);
+                        break;
+
+                    case error::NOT_A_FILE:
+                        msg.Write("Not a regular file", 18);
+                        break;
+
+                    case error::NOT_A_DIRECTORY:
+                        msg.Write("Not a directory", 15);
+                        break;
+
                     case error::UNKNOWN_COMMAND:
                         msg.Write("Unknown command", 15);
                         break;
@@ -312,6 +1122,39 @@ namespace zelix::cli
                         msg.Write("Unknown flag", 12);
                         break;
 
+                    case error::INVALID_ENV:
+                        msg.Write("Invalid value in environment variable ", 38);
+                        msg.Write(global_error.source.Ptr(), global_error.source.Size());
+                        break;
+
+                    case error::INVALID_CONFIG:
+                        msg.Write("Invalid value in configuration key ", 35);
+                        msg.Write(global_error.source.Ptr(), global_error.source.Size());
+                        break;
+
+                    case error::MALFORMED_CONFIG:
+                        msg.Write("Malformed configuration line ", 29);
+                        msg.Write(global_error.source.Ptr(), global_error.source.Size());
+                        break;
+
+                    case error::UNTERMINATED_QUOTE:
+                        msg.Write("Unterminated quote", 18);
+                        break;
+
+                    case error::UNTERMINATED_ESCAPE:
+                        msg.Write("Trailing backslash", 18);
+                        break;
+
+                    case error::TOO_MANY_ARGUMENTS:
+                        msg.Write("Too many arguments", 18);
+                        break;
+
+                    case error::SPLIT_VARIADIC:
+                        msg.Write("Arguments for ", 14);
+                        msg.Write(global_error.source.Ptr(), global_error.source.Size());
+                        msg.Write(" must be given together", 23);
+                        break;
+
                     default:
                         break;
                 }
@@ -387,6 +1230,48 @@ namespace zelix::cli
                         msg.Write("change the value to match the expected type", 43);
                         break;
 
+                    case error::MISSING_REQUIRED:
+                        msg.Write("add it to the command line", 26);
+                        break;
+
+                    case error::CONFLICTING_ARGUMENTS:
+                        msg.Write("remove one of them", 18);
+                        break;
+
+                    case error::MISSING_DEPENDENCY:
+                        msg.Write("add it as well", 14);
+                        break;
+
+                    case error::INVALID_UTF8:
+                        msg.Write("re-encode it as UTF-8", 21);
+                        break;
+
+                    case error::CONTROL_CHARACTER:
+                        msg.Write("remove it", 9);
+                        break;
+
+                    case error::LIMIT_EXCEEDED:
+                        msg.Write("pass fewer or shorter arguments", 31);
+                        break;
+
+                    case error::PATH_NOT_FOUND:
+                    case error::NOT_A_FILE:
+                    case error::NOT_A_DIRECTORY:
+                        msg.Write("check the path", 14);
+                        break;
+
+                    case error::INVALID_CHOICE:
+                    {
+                        const size_t flag = schema_.find_flag(global_error.source);
+                        const auto &val = flag != schema::NONE
+                            ? schema_.values[flag]
+                            : schema_.command(global_error.source);
+
+                        msg.Write("use one of: ", 12);
+                        write_choices(msg, *val.get<choice>().set(), ' ');
+                        break;
+                    }
+
                     case error::UNKNOWN_COMMAND:
                         msg.Write("use --help to see a list of commands", 36);
                         break;
@@ -395,6 +1280,34 @@ namespace zelix::cli
                         msg.Write("use --help to see a list of flags", 33);
                         break;
 
+                    case error::INVALID_ENV:
+                        msg.Write("change the variable to match the expected type", 46);
+                        break;
+
+                    case error::INVALID_CONFIG:
+                        msg.Write("change the key to match the expected type", 41);
+                        break;
+
+                    case error::MALFORMED_CONFIG:
+                        msg.Write("close the section header", 24);
+                        break;
+
+                    case error::UNTERMINATED_QUOTE:
+                        msg.Write("close the quote", 15);
+                        break;
+
+                    case error::UNTERMINATED_ESCAPE:
+                        msg.Write("escape the backslash or remove it", 33);
+                        break;
+
+                    case error::TOO_MANY_ARGUMENTS:
+                        msg.Write("pass fewer arguments", 20);
+                        break;
+
+                    case error::SPLIT_VARIADIC:
+                        msg.Write("move the flags before or after them", 35);
+                        break;
+
                     default:
                         break;
                 }
@@ -463,67 +1376,21 @@ namespace zelix::cli
             msg.Write(Celery::Misc::Ansi::Reset, 4);
             msg.Write("\n\n", 2);
 
-            if (!commands.empty())
+            if (image_ != nullptr)
             {
-                msg.Write(Celery::Misc::Ansi::Yellow, 5);
-                msg.Write(
-                    "Available commands:\n",
-                    20
-                );
-                msg.Write(Celery::Misc::Ansi::Reset, 4);
+                const auto listing = image_->listing<Unicode>();
+                msg.Write(listing.Ptr(), listing.Size());
             }
-
-            for (const auto &[name, val] : commands)
+            else
             {
-                msg.Write(Celery::Misc::Ansi::Bright::Black, 5);
-                msg.Write("  ", 2);
-                if constexpr (Unicode)
-                {
-                    msg.Write("➤ ");
-                }
-                else
-                {
-                    msg.Write("> ", 2);
-                }
-                msg.Write(Celery::Misc::Ansi::Reset, 4);
-                msg.Write(Celery::Misc::Ansi::Cyan, 5);
-                msg.Write(name.Ptr(), name.Size());
-
-                // Honor aliases
-                const auto &alias = cmd_aliases[name];
-                msg.Write(", ", 2);
-                msg.Write(alias.Ptr(), alias.Size());
-
-                // Write the value's info
-                write_val_info(msg, name, val, false);
-            }
-
-            if (!flags.empty())
-            {
-                msg.Write(Celery::Misc::Ansi::Yellow, 5);
-                msg.Write(
-                    "Available flags:\n",
-                    17
-                );
-                msg.Write(Celery::Misc::Ansi::Reset, 4);
-            }
-
-            for (auto &[name, val] : flags)
-            {
-                msg.Write("  ", 2);
-                msg.Write(Celery::Misc::Ansi::Bright::Blue, 5);
-                msg.Write("--", 2);
-                msg.Write(name.Ptr(), name.Size());
-
-                // Honor aliases
-                const auto &alias = flag_aliases[name];
-                msg.Write(", -", 3);
-                msg.Write(alias.Ptr(), alias.Size());
-
-                write_val_info(msg, name, val, true, 1);
+                write_listing<Unicode>(msg);
             }
 
             return msg;
         }
     };
-}
\ No newline at end of file
+}
+
+#ifdef ZELIX_CLI_COMPILED
+#include "instantiate.h"
+#endif
@@ -28,291 +28,832 @@
 //
 
 #pragma once
-#include <charconv>
-#include "ankerl/unordered_dense.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <vector>
 #include "celery/string/external.h"
-#include "celery/misc/hash.h"
+#include "celery/string/string.h"
+#include "env.h"
+#include "reader.h"
+#include "error.h"
+#include "path.h"
+#include "schema.h"
+#include "serialize.h"
+#include "traits.h"
+#include "utf8.h"
 #include "value.h"
-#include <celery/misc/string_equal.h>
+#include "view.h"
 
 namespace zelix::cli
 {
-    class error
+    /**
+     * @brief A command, flag or positional as it appeared in argv.
+     */
+    class occurrence
     {
     public:
-        enum type
-        {
-            UNKNOWN,
-            EXPECTED_VALUE,
-            NOT_EXPECTED_VALUE,
-            UNKNOWN_COMMAND,
-            UNKNOWN_FLAG,
-            TYPE_MISMATCH,
-        };
-
-        type error_type = UNKNOWN; ///< Type of the error
-        size_t argv_pos = 0; ///< Position in the argv array where the error occurred
+        uint32_t slot = 0; ///< Slot of the command or flag, or index of the positional
+        uint32_t argv_pos = 0; ///< Position of the command, flag or positional
+        Celery::Str::External text; ///< Value or positional argument, empty if none was given
+        bool positional = false;
     };
 
-    inline error global_error; ///< Global error object to store the last error
-
     class args
     {
-        ankerl::unordered_dense::map<
-            Celery::Str::External,
-            value,
-            Celery::Misc::Hash,
-			Celery::Misc::StringEquality
-        > &commands;
-
-        ankerl::unordered_dense::map<
-            Celery::Str::External,
-            value,
-            Celery::Misc::Hash,
-			Celery::Misc::StringEquality
-        > &flags;
-
-        // Aliases (cmd name -> alias)
-        ankerl::unordered_dense::map<
-            Celery::Str::External,
-            Celery::Str::External,
-            Celery::Misc::Hash,
-			Celery::Misc::StringEquality
-        > &cmd_aliases;
-
-        ankerl::unordered_dense::map<
-            Celery::Str::External,
-            Celery::Str::External,
-            Celery::Misc::Hash,
-			Celery::Misc::StringEquality
-        > &flag_aliases;
-
-        // Aliases (alias -> cmd name)
-        ankerl::unordered_dense::map<
-            Celery::Str::External,
-            Celery::Str::External,
-            Celery::Misc::Hash,
-			Celery::Misc::StringEquality
-        > &cmd_aliases_reverse;
-
-        ankerl::unordered_dense::map<
-            Celery::Str::External,
-            Celery::Str::External,
-            Celery::Misc::Hash,
-			Celery::Misc::StringEquality
-        > &flag_aliases_reverse;
-
-        ankerl::unordered_dense::map<
-            Celery::Str::External,
-            Celery::Str::External,
-            Celery::Misc::Hash,
-			Celery::Misc::StringEquality
-        > str_args; ///< String arguments map
-
-        ankerl::unordered_dense::map<
-            Celery::Str::External,
-            int,
-            Celery::Misc::Hash,
-			Celery::Misc::StringEquality
-        > int_args; ///< Integer arguments map
-
-        ankerl::unordered_dense::map<
-            Celery::Str::External,
-            float,
-            Celery::Misc::Hash,
-			Celery::Misc::StringEquality
-        > float_args; ///< Float arguments map
-
-        ankerl::unordered_dense::map<
-            Celery::Str::External,
-            bool,
-            Celery::Misc::Hash,
-			Celery::Misc::StringEquality
-        > bool_args; ///< Boolean arguments map
-
-        ankerl::unordered_dense::map<
-            Celery::Str::External,
-            Celery::Str::External,
-            Celery::Misc::Hash,
-			Celery::Misc::StringEquality
-        > str_flags; ///< String flags map
-
-        ankerl::unordered_dense::map<
-            Celery::Str::External,
-            int,
-            Celery::Misc::Hash,
-			Celery::Misc::StringEquality
-        > int_flags; ///< Integer flags map
-
-        ankerl::unordered_dense::map<
-            Celery::Str::External,
-            float,
-            Celery::Misc::Hash,
-			Celery::Misc::StringEquality
-        > float_flags; ///< Float flags map
-
-        ankerl::unordered_dense::map<
-            Celery::Str::External,
-            bool,
-            Celery::Misc::Hash,
-			Celery::Misc::StringEquality
-        > bool_flags; ///< Boolean flags map
+    public:
+        /**
+         * @brief Where the value of a flag came from.
+         */
+        enum source
+        {
+            DEFAULT,
+            ARGV,
+            ENV,
+            CONFIG,
+        };
+
+    private:
+        /**
+         * @brief A value whose conversion was deferred until it is read.
+         */
+        class pending_value
+        {
+        public:
+            Celery::Str::External value; ///< The raw value
+            size_t argv_pos = 0; ///< Where the value came from, for error reporting
+            error::type error_type = error::TYPE_MISMATCH; ///< Error to report if the conversion fails
+            Celery::Str::External origin; ///< Variable or key the value came from, if not argv
+        };
+
+        /**
+         * @brief An event applied during a journaled parse, see `reparse()`.
+         */
+        class step
+        {
+        public:
+            event ev; ///< The event, without its `val`: registrars may move the schema's values
+            size_t text_offset = 0; ///< Offset of `ev.text` within its token
+            bool converted = false; ///< Whether `stored` holds the converted value
+            value::storage stored;
+        };
+
+        /**
+         * @brief Where a journaled parse was right before a token.
+         */
+        class token_mark
+        {
+        public:
+            reader::checkpoint point;
+            size_t steps = 0; ///< Steps applied before the token
+        };
+
+        schema &schema_; ///< Commands, flags and positionals registered in the app
+        bool lazy = false; ///< Whether conversions are deferred until values are read
+
+        name_map<Celery::Str::External> str_args; ///< String arguments map
+        name_map<int> int_args; ///< Integer arguments map
+        name_map<float> float_args; ///< Float arguments map
+        name_map<bool> bool_args; ///< Boolean arguments map
+        name_map<choice> choice_args; ///< Choice arguments map
+        name_map<Celery::Str::External> str_flags; ///< String flags map
+        name_map<int> int_flags; ///< Integer flags map
+        name_map<float> float_flags; ///< Float flags map
+        name_map<bool> bool_flags; ///< Boolean flags map
+        name_map<choice> choice_flags; ///< Choice flags map
+        name_map<value::storage> custom_args; ///< User-defined arguments map
+        name_map<value::storage> custom_flags; ///< User-defined flags map
+
+        std::vector<argv_view> positional_args; ///< Positional values, by index
+        argv_view passthrough_args; ///< Arguments after the "--" terminator
+
+        name_map<source> flag_sources; ///< Flags whose value came from outside argv
+        name_map<Celery::Str::External> bound_texts; ///< Text written into bound flags, kept for `serialize()`
+        void *object = nullptr; ///< Object member bindings are written into
+
+        std::vector<occurrence> occurrence_log; ///< Everything given in argv, in order
+        std::vector<std::unique_ptr<char[]>> config_strings; ///< Null-terminated copies of configuration values
+        slot_set seen; ///< Slots given in argv, the environment or the configuration file
+        std::vector<size_t> slot_pos; ///< Where each seen slot was given, 0 outside argv
+
+        path_batch paths; ///< Paths to check once parsing is done
+        std::vector<size_t> path_jobs; ///< Job of each slot in `paths`, if any
+
+        // Values waiting to be converted (lazy mode only)
+        name_map<pending_value> pending_args;
+        name_map<pending_value> pending_flags;
 
         Celery::Str::External cmd;
+        size_t cmd_slot = SIZE_MAX;
+
+        // Journal of the last parse, so edited vectors can be parsed incrementally
+        bool journaling = false;
+        std::vector<step> steps;
+        std::vector<token_mark> marks; ///< By token, starting at argv[1]
+        std::vector<char> token_text; ///< The tokens the journal was made from
+        std::vector<size_t> token_ends; ///< End of each token in `token_text`
 
-        bool parse_flag(
-            Celery::Str::External &flag,
-            bool &waiting_value,
-            value::type &expected,
-            const int i
+        template <typename T, typename Flag>
+        bool parse_value(
+            const Celery::Str::External &value,
+            Celery::Str::External &name
         )
         {
-            // Handle aliases
-            if (flag_aliases_reverse.contains(flag))
+            T result;
+            if constexpr (
+                std::is_same_v<T, choice>
+                || value_traits<T>::kind == value::CUSTOM
+            )
             {
-                const auto &alias = flag_aliases_reverse.at(flag);
-                flag = alias;
+                // Choices are resolved against the registered set, and
+                // user types may only fill in part of their default
+                // (a blank one when it is computed, see `computed`)
+                result = std::is_same_v<Flag, bool>
+                    ? schema_.flag(name).get<T>()
+                    : schema_.command(name).get<T>();
             }
 
-            // Get the flag from the map
-            if (flags.contains(flag))
+            if (!value_traits<T>::parse(value, result))
             {
-                const auto &flag_val = flags.at(flag);
-                waiting_value = flag_val.get_type() != value::BOOL;
-                expected = flag_val.get_type();
+                return false;
+            }
 
-                if (!waiting_value)
+            if constexpr (std::is_same_v<T, Celery::Str::External>)
+            {
+                if constexpr (std::is_same_v<Flag, bool>)
+                {
+                    str_flags[name] = result;
+                }
+                else
+                {
+                    str_args[name] = result;
+                }
+            }
+            else if constexpr (std::is_same_v<T, bool>)
+            {
+                if constexpr (std::is_same_v<Flag, bool>)
+                {
+                    bool_flags[name] = result;
+                }
+                else
                 {
-                    bool_flags[flag] = true;
+                    bool_args[name] = result;
+                }
+            }
+            else if constexpr (std::is_same_v<T, int>)
+            {
+                if constexpr (std::is_same_v<Flag, bool>)
+                {
+                    int_flags[name] = result;
+                }
+                else
+                {
+                    int_args[name] = result;
+                }
+            }
+            else if constexpr (std::is_same_v<T, float>)
+            {
+                if constexpr (std::is_same_v<Flag, bool>)
+                {
+                    float_flags[name] = result;
+                }
+                else
+                {
+                    float_args[name] = result;
+                }
+            }
+            else if constexpr (std::is_same_v<T, choice>)
+            {
+                if constexpr (std::is_same_v<Flag, bool>)
+                {
+                    choice_flags[name] = result;
+                }
+                else
+                {
+                    choice_args[name] = result;
                 }
             }
             else
             {
-                global_error.error_type = error::UNKNOWN_FLAG;
-                global_error.argv_pos = i;
-                return false;
+                static_assert(
+                    value_traits<T>::kind == value::CUSTOM,
+                    "Unsupported type for value parsing"
+                );
+
+                auto &custom = std::is_same_v<Flag, bool> ? custom_flags : custom_args;
+                value::wrap(custom[name], result);
             }
 
             return true;
         }
 
-        template <typename T, typename Flag>
-        bool parse_value(
-            const Celery::Str::External &value,
+        template <typename Flag>
+        bool parse_as(
+            const value &val,
+            const Celery::Str::External &text,
             Celery::Str::External &name
         )
         {
-            if constexpr (std::is_same_v<T, Celery::Str::External>)
+            switch (val.get_type())
             {
-                if constexpr (std::is_same_v<Flag, bool>)
+                case value::BOOL:
+                    return parse_value<bool, Flag>(text, name);
+
+                case value::FLOAT:
+                    return parse_value<float, Flag>(text, name);
+
+                case value::INTEGER:
+                    return parse_value<int, Flag>(text, name);
+
+                case value::STRING:
+                    return parse_value<Celery::Str::External, Flag>(text, name);
+
+                case value::CHOICE:
+                    return parse_value<choice, Flag>(text, name);
+
+                case value::CUSTOM:
                 {
-                    str_flags[name] = value;
+                    // The type is only known at registration, go through its traits
+                    auto result = val.get_default();
+                    if (!val.get_ops().parse(text, result))
+                    {
+                        return false;
+                    }
+
+                    auto &custom = std::is_same_v<Flag, bool> ? custom_flags : custom_args;
+                    custom[name] = result;
+                    return true;
                 }
-                else
+            }
+
+            return false;
+        }
+
+        [[nodiscard]] const binding *bound(const value &val) const
+        {
+            const auto slot = val.get_slot();
+            if (slot >= schema_.bindings.size() || schema_.bindings[slot].write == nullptr)
+            {
+                return nullptr;
+            }
+
+            return &schema_.bindings[slot];
+        }
+
+        bool write_bound(
+            const binding &dest,
+            const value &val,
+            const Celery::Str::External *text
+        ) const
+        {
+            // Given values never need the computed default
+            const auto &base = text != nullptr ? val.get_default() : schema_.default_of(val);
+            return dest.write(dest.target != nullptr ? dest.target : object, val, base, text);
+        }
+
+        /**
+         * @brief Parses a value, or records it for later in lazy mode.
+         *
+         * Bound flags are always written right away.
+         */
+        template <typename Flag>
+        bool store(
+            const value &val,
+            const Celery::Str::External &text,
+            Celery::Str::External &name,
+            const size_t argv_pos,
+            const error::type error_type = error::TYPE_MISMATCH,
+            const Celery::Str::External &origin = Celery::Str::External("", 0)
+        )
+        {
+            if (const auto *dest = bound(val))
+            {
+                if (!write_bound(*dest, val, &text))
                 {
-                    str_args[name] = value;
+                    return false;
                 }
 
+                bound_texts[name] = text;
                 return true;
             }
-            else if constexpr (std::is_same_v<T, bool>)
+
+            if (!lazy)
             {
-                if constexpr (std::is_same_v<Flag, bool>)
+                return parse_as<Flag>(val, text, name);
+            }
+
+            auto &pending = std::is_same_v<Flag, bool> ? pending_flags : pending_args;
+            pending[name] = pending_value{text, argv_pos, error_type, origin};
+            return true;
+        }
+
+        /**
+         * @brief Writes defaults into bound flags that were never given.
+         */
+        void write_defaults() const
+        {
+            if (schema_.bindings.empty())
+            {
+                return;
+            }
+
+            for (size_t slot = 0; slot < schema_.slots; ++slot)
+            {
+                if (schema_.command_slots.test(slot))
                 {
-                    if (memcmp(value.Ptr(), "true", value.Size()) == 0)
-                    {
-                        bool_flags[name] = true;
-                        return true;
-                    }
+                    continue;
+                }
 
-                    if (memcmp(value.Ptr(), "false", value.Size()) == 0)
-                    {
-                        bool_flags[name] = false;
-                        return true;
-                    }
+                const auto &val = schema_.values[slot];
+                if (
+                    const auto *dest = bound(val);
+                    dest != nullptr && !seen.test(val.get_slot()) && active(val)
+                )
+                {
+                    write_bound(*dest, val, nullptr);
+                }
+            }
+        }
+
+        /**
+         * @brief Converts a deferred value, if any, into its typed map.
+         *
+         * Values that fail to convert stay deferred, so every access
+         * reports the error again instead of returning the default.
+         */
+        template <typename T, typename Flag>
+        void resolve(const Celery::Str::External &name)
+        {
+            auto &pending = std::is_same_v<Flag, bool> ? pending_flags : pending_args;
+            const auto it = pending.find(name);
+            if (it == pending.end())
+            {
+                return;
+            }
+
+            auto key = it->first;
+            const auto entry = it->second;
+
+            using Stored = std::conditional_t<
+                std::is_same_v<T, const char *>,
+                Celery::Str::External,
+                T
+            >;
+
+            if (!parse_value<Stored, Flag>(entry.value, key))
+            {
+                global_error.error_type = entry.error_type;
+                global_error.argv_pos = entry.argv_pos;
+                global_error.source = entry.origin;
+                return;
+            }
+
+            pending.erase(key);
+        }
+
+        /**
+         * @brief Stores an already converted value.
+         */
+        void put(
+            const value &val,
+            const Celery::Str::External &name,
+            const bool command,
+            const value::storage &stored
+        )
+        {
+            switch (val.get_type())
+            {
+                case value::STRING:
+                {
+                    auto &map = command ? str_args : str_flags;
+                    map[name] = std::get<Celery::Str::External>(stored);
+                    break;
+                }
+
+                case value::BOOL:
+                {
+                    auto &map = command ? bool_args : bool_flags;
+                    map[name] = std::get<bool>(stored);
+                    break;
+                }
+
+                case value::FLOAT:
+                {
+                    auto &map = command ? float_args : float_flags;
+                    map[name] = std::get<float>(stored);
+                    break;
+                }
+
+                case value::INTEGER:
+                {
+                    auto &map = command ? int_args : int_flags;
+                    map[name] = std::get<int>(stored);
+                    break;
+                }
+
+                case value::CHOICE:
+                {
+                    auto &map = command ? choice_args : choice_flags;
+                    map[name] = std::get<choice>(stored);
+                    break;
+                }
+
+                case value::CUSTOM:
+                {
+                    auto &custom = command ? custom_args : custom_flags;
+                    custom[name] = stored;
+                    break;
+                }
+            }
+        }
+
+        /**
+         * @brief Gets a value stored by `put()` or a conversion.
+         */
+        [[nodiscard]] value::storage take(
+            const value &val,
+            const Celery::Str::External &name,
+            const bool command
+        ) const
+        {
+            switch (val.get_type())
+            {
+                case value::STRING:
+                    return value::storage(std::in_place_type<Celery::Str::External>, (command ? str_args : str_flags).at(name));
+
+                case value::BOOL:
+                    return value::storage(std::in_place_type<bool>, (command ? bool_args : bool_flags).at(name));
+
+                case value::FLOAT:
+                    return value::storage(std::in_place_type<float>, (command ? float_args : float_flags).at(name));
+
+                case value::INTEGER:
+                    return value::storage(std::in_place_type<int>, (command ? int_args : int_flags).at(name));
+
+                case value::CHOICE:
+                    return value::storage(std::in_place_type<choice>, (command ? choice_args : choice_flags).at(name));
+
+                case value::CUSTOM:
+                    return (command ? custom_args : custom_flags).at(name);
+            }
+
+            return val.get_default();
+        }
+
+        void store_default(
+            const value &val,
+            const Celery::Str::External &name,
+            const bool command
+        )
+        {
+            put(val, name, command, schema_.default_of(val));
+        }
+
+        template <typename T>
+        void serialize_map(
+            blob::writer &out,
+            const name_map<T> &map,
+            const bool command
+        ) const
+        {
+            for (const auto &[name, val] : map)
+            {
+                const auto &def = command ? schema_.command(name) : schema_.flag(name);
+                const auto src = flag_sources.find(name);
+                const uint8_t origin = command || src == flag_sources.end() ? ARGV : src->second;
+
+                if constexpr (std::is_same_v<T, value::storage>)
+                {
+                    // User types travel formatted, and are parsed back on access
+                    Celery::Str::String text;
+                    def.get_ops().format(val, text);
+                    out.add(def.get_slot(), command, origin, Celery::Str::External(text.c_str()), true);
                 }
                 else
                 {
-                    if (memcmp(value.Ptr(), "true", value.Size()) == 0)
-                    {
-                        bool_args[name] = true;
-                        return true;
-                    }
+                    out.add(def.get_slot(), command, origin, val);
+                }
+            }
+        }
 
-                    if (memcmp(value.Ptr(), "false", value.Size()) == 0)
-                    {
-                        bool_args[name] = false;
-                        return true;
-                    }
+        bool parse_env()
+        {
+            for (const size_t slot : schema_.env_slots)
+            {
+                const auto &flag_val = schema_.values[slot];
+                const auto &env = schema_.slot_envs[slot];
+                if (seen.test(flag_val.get_slot()) || !active(flag_val))
+                {
+                    continue; // The command line always wins
+                }
+
+                // The environment is only indexed the first time we get here
+                Celery::Str::External env_val;
+                if (!environment::lookup(env, env_val))
+                {
+                    continue;
                 }
 
-                return false; // Invalid boolean value
+                if (flag_val.get_type() == value::STRING && !check_text(env_val, 0, env))
+                {
+                    return false;
+                }
+
+                auto flag_name = schema_.slot_names[slot];
+                if (!store<bool>(flag_val, env_val, flag_name, 0, error::INVALID_ENV, env))
+                {
+                    global_error.error_type = error::INVALID_ENV;
+                    global_error.argv_pos = 0;
+                    global_error.source = env;
+                    return false;
+                }
+
+                flag_sources[flag_name] = ENV;
+                mark(flag_val.get_slot(), 0);
+                queue_path(flag_val.get_slot(), env_val, 0, env);
             }
-            else if constexpr (std::is_same_v<T, int>)
+
+            return true;
+        }
+
+        /**
+         * @brief Validates a string value, if the schema asks for it.
+         */
+        bool check_text(
+            const Celery::Str::External &text,
+            const size_t argv_pos,
+            const Celery::Str::External &origin
+        ) const
+        {
+            if (!schema_.check_utf8)
             {
-                int result = 0;
-                const auto value_ptr = value.Ptr();
+                return true;
+            }
 
-                // Iterate over the ptr
-                for (size_t i = 0; i < value.Size(); ++i)
+            const size_t offset = utf8::validate(text.Ptr(), text.Size(), schema_.reject_control);
+            if (offset == utf8::NONE)
+            {
+                return true;
+            }
+
+            // A character that is valid UTF-8 can only fail as a control character
+            global_error.error_type = utf8::validate(text.Ptr() + offset, text.Size() - offset) != 0
+                ? error::CONTROL_CHARACTER
+                : error::INVALID_UTF8;
+            global_error.argv_pos = argv_pos;
+            global_error.source = origin;
+            global_error.offset = offset;
+            return false;
+        }
+
+        /**
+         * @brief Queues the value of a slot for the path checks, if it has one.
+         *
+         * A slot given again (e.g. in argv after the configuration file)
+         * only has its last value checked.
+         */
+        void queue_path(
+            const size_t slot,
+            const Celery::Str::External &text,
+            const size_t argv_pos,
+            const Celery::Str::External &origin
+        )
+        {
+            if (slot >= schema_.slot_paths.size() || schema_.slot_paths[slot] == path_check::NONE)
+            {
+                return;
+            }
+
+            path_jobs.resize(schema_.slots, path_batch::NONE);
+            if (path_jobs[slot] == path_batch::NONE)
+            {
+                path_jobs[slot] = paths.add(text, schema_.slot_paths[slot], argv_pos, origin);
+            }
+            else
+            {
+                paths.replace(path_jobs[slot], text, argv_pos, origin);
+            }
+        }
+
+        /**
+         * @brief Runs the queued path checks in one batch.
+         */
+        bool check_paths()
+        {
+            if (paths.empty())
+            {
+                return true;
+            }
+
+            const size_t failed = paths.run();
+            if (failed == path_batch::NONE)
+            {
+                return true;
+            }
+
+            const auto &job = paths.at(failed);
+            global_error.error_type = paths.result(failed);
+            global_error.argv_pos = job.argv_pos;
+            global_error.source = job.origin;
+            return false;
+        }
+
+        /**
+         * @brief Whether a flag belongs to the selected command, or to none.
+         */
+        [[nodiscard]] bool active(const size_t slot) const
+        {
+            const size_t owner = schema_.owners[slot];
+            return owner == SIZE_MAX || owner == cmd_slot;
+        }
+
+        [[nodiscard]] bool active(const value &flag) const
+        {
+            return active(flag.get_slot());
+        }
+
+        void mark(const size_t slot, const size_t argv_pos)
+        {
+            if (slot >= slot_pos.size())
+            {
+                // Registered while parsing, by a command's registrar
+                slot_pos.resize(schema_.slots, 0);
+            }
+
+            seen.set(slot);
+            slot_pos[slot] = argv_pos;
+        }
+
+        bool fail_constraint(const error::type type, const size_t argv_pos, const size_t culprit)
+        {
+            global_error.error_type = type;
+            global_error.argv_pos = argv_pos;
+            global_error.source = schema_.slot_names[culprit];
+            return false;
+        }
+
+        bool check_constraints()
+        {
+            // Flags of commands that weren't selected stay registered,
+            // but only exist under their command
+            for (
+                size_t missing = seen.first_missing(schema_.required);
+                missing != SIZE_MAX;
+                missing = seen.first_missing(schema_.required, missing + 1)
+            )
+            {
+                if (active(missing))
+                {
+                    return fail_constraint(error::MISSING_REQUIRED, 0, missing);
+                }
+            }
+
+            for (const auto &group : schema_.exclusive_groups)
+            {
+                if (seen.count_common(group) < 2)
                 {
-                    const char c = value_ptr[i];
-                    if (c < '0' || c > '9')
+                    continue;
+                }
+
+                // Blame the last one given, pointing back at the first
+                size_t first = SIZE_MAX;
+                size_t last = SIZE_MAX;
+                for (size_t slot = 0; slot < schema_.slots; ++slot)
+                {
+                    if (!group.test(slot) || !seen.test(slot))
                     {
-                        return false; // Invalid integer value
+                        continue;
                     }
 
-                    result = result * 10 + (c - '0');
+                    if (first == SIZE_MAX || slot_pos[slot] < slot_pos[first])
+                    {
+                        first = slot;
+                    }
+
+                    if (last == SIZE_MAX || slot_pos[slot] >= slot_pos[last])
+                    {
+                        last = slot;
+                    }
                 }
 
-                if constexpr (std::is_same_v<Flag, bool>)
+                return fail_constraint(error::CONFLICTING_ARGUMENTS, slot_pos[last], first);
+            }
+
+            for (const auto &dep : schema_.dependencies)
+            {
+                if (!seen.test(dep.slot))
                 {
-                    int_flags[name] = result;
+                    continue;
                 }
-                else
+
+                if (
+                    const auto missing = seen.first_missing(dep.needs);
+                    missing != SIZE_MAX
+                )
                 {
-                    int_args[name] = result;
+                    return fail_constraint(error::MISSING_DEPENDENCY, slot_pos[dep.slot], missing);
                 }
+            }
+
+            return true;
+        }
+
+        /**
+         * @brief Copies a value into a null-terminated string owned by this object.
+         */
+        Celery::Str::External keep_string(const Celery::Str::External &text)
+        {
+            auto &copy = config_strings.emplace_back(std::make_unique<char[]>(text.Size() + 1));
+            memcpy(copy.get(), text.Ptr(), text.Size());
+            copy[text.Size()] = '\0';
+            return Celery::Str::External(copy.get(), text.Size());
+        }
 
+        bool parse_config()
+        {
+            const auto &file = schema_.config;
+            if (file.empty())
+            {
                 return true;
             }
-            else if constexpr (std::is_same_v<T, float>)
+
+            // The file was indexed when it was opened
+            for (const auto &entry : file.entries())
             {
-                float result = 0.0f;
-                const auto value_ptr = value.Ptr();
+                // Sections only apply to the command they are named after
+                if (
+                    entry.section.Size() != 0
+                    && !Celery::Misc::StringEquality()(entry.section, cmd)
+                )
+                {
+                    continue;
+                }
+
+                // Keys that don't match a flag are never converted
+                const size_t slot = schema_.find_flag(entry.key);
+                if (slot == schema::NONE || !active(schema_.values[slot]))
+                {
+                    continue;
+                }
+
+                auto name = schema_.slot_names[slot];
+                const auto &flag_val = schema_.values[slot];
+
+                // argv and the environment take precedence, but later
+                // entries in the file override earlier ones
+                if (seen.test(flag_val.get_slot()))
+                {
+                    if (
+                        const auto src = flag_sources.find(name);
+                        src == flag_sources.end() || src->second != CONFIG
+                    )
+                    {
+                        continue;
+                    }
+                }
 
                 if (
-                    auto [ptr, ec] = std::from_chars(value_ptr, value_ptr + value.Size(), result);
-                    ec != std::errc()
-                ) {
-                    return false; // Invalid float value
+                    flag_val.get_type() == value::STRING
+                    && !check_text(entry.value, 0, entry.key)
+                )
+                {
+                    return false;
                 }
 
-                if constexpr (std::is_same_v<Flag, bool>)
+                // Values are slices of the mapped file, which are not
+                // null-terminated, so variables holding C strings get a copy
+                auto text = entry.value;
+                if (const auto *dest = bound(flag_val); dest != nullptr && dest->c_string)
                 {
-                    float_flags[name] = result;
+                    text = keep_string(entry.value);
                 }
-                else
+
+                if (!store<bool>(flag_val, text, name, 0, error::INVALID_CONFIG, entry.key))
                 {
-                    float_args[name] = result;
+                    global_error.error_type = error::INVALID_CONFIG;
+                    global_error.argv_pos = 0;
+                    global_error.source = entry.key;
+                    return false;
                 }
 
-                return true;
+                flag_sources[name] = CONFIG;
+                mark(flag_val.get_slot(), 0);
+                queue_path(flag_val.get_slot(), entry.value, 0, entry.key);
             }
-            else
-            {
-                static_assert(
-                    false,
-                    "Unsupported type for value parsing"
-                );
 
-                return false; // Should never reach here
-            }
+            return true;
         }
 
         template <typename T, typename Flag>
         T val(const Celery::Str::External &name)
         {
+            if (lazy)
+            {
+                resolve<T, Flag>(name);
+            }
+
             if constexpr (
                 std::is_same_v<T, Celery::Str::External>
                 || std::is_same_v<T, const char *>
@@ -324,8 +865,8 @@ namespace zelix::cli
                     if (!str_flags.contains(name))
                     {
                         // Return default value
-                        const auto &def = flags.at(name);
-                        return def.get<T>();
+                        const auto &def = schema_.flag(name);
+                        return def.get<T>(schema_.default_of(def));
                     }
 
                     return str_flags.at(name);
@@ -336,8 +877,8 @@ namespace zelix::cli
                     if (!str_args.contains(name))
                     {
                         // Return default value
-                        const auto &def = commands.at(name);
-                        return def.get<T>();
+                        const auto &def = schema_.command(name);
+                        return def.get<T>(schema_.default_of(def));
                     }
 
                     return str_args.at(name);
@@ -351,8 +892,8 @@ namespace zelix::cli
                     if (!int_flags.contains(name))
                     {
                         // Return default value
-                        const auto &def = flags.at(name);
-                        return def.get<T>();
+                        const auto &def = schema_.flag(name);
+                        return def.get<T>(schema_.default_of(def));
                     }
 
                     return int_flags.at(name);
@@ -363,8 +904,8 @@ namespace zelix::cli
                     if (!int_args.contains(name))
                     {
                         // Return default value
-                        const auto &def = commands.at(name);
-                        return def.get<T>();
+                        const auto &def = schema_.command(name);
+                        return def.get<T>(schema_.default_of(def));
                     }
 
                     return int_args.at(name);
@@ -378,8 +919,8 @@ namespace zelix::cli
                     if (!float_flags.contains(name))
                     {
                         // Return default value
-                        const auto &def = flags.at(name);
-                        return def.get<T>();
+                        const auto &def = schema_.flag(name);
+                        return def.get<T>(schema_.default_of(def));
                     }
 
                     return float_flags.at(name);
@@ -390,486 +931,588 @@ namespace zelix::cli
                     if (!float_args.contains(name))
                     {
                         // Return default value
-                        const auto &def = commands.at(name);
-                        return def.get<T>();
+                        const auto &def = schema_.command(name);
+                        return def.get<T>(schema_.default_of(def));
+                    }
+
+                    return float_args.at(name);
+                }
+            }
+            else if constexpr (std::is_same_v<T, bool>)
+            {
+                if constexpr (std::is_same_v<Flag, bool>)
+                {
+                    // Get from the flags
+                    if (!bool_flags.contains(name))
+                    {
+                        // Return default value
+                        const auto &def = schema_.flag(name);
+                        return def.get<T>(schema_.default_of(def));
+                    }
+
+                    return bool_flags.at(name);
+                }
+                else
+                {
+                    // Get from the commands
+                    if (!bool_args.contains(name))
+                    {
+                        // Return default value
+                        const auto &def = schema_.command(name);
+                        return def.get<T>(schema_.default_of(def));
                     }
 
-                    return float_args.at(name);
+                    return bool_args.at(name);
                 }
             }
-            else if constexpr (std::is_same_v<T, bool>)
+            else if constexpr (std::is_same_v<T, choice>)
             {
                 if constexpr (std::is_same_v<Flag, bool>)
                 {
                     // Get from the flags
-                    if (!bool_flags.contains(name))
+                    if (!choice_flags.contains(name))
                     {
                         // Return default value
-                        const auto &def = flags.at(name);
-                        return def.get<T>();
+                        const auto &def = schema_.flag(name);
+                        return def.get<T>(schema_.default_of(def));
                     }
 
-                    return bool_flags.at(name);
+                    return choice_flags.at(name);
                 }
                 else
                 {
                     // Get from the commands
-                    if (!bool_args.contains(name))
+                    if (!choice_args.contains(name))
                     {
                         // Return default value
-                        const auto &def = commands.at(name);
-                        return def.get<T>();
+                        const auto &def = schema_.command(name);
+                        return def.get<T>(schema_.default_of(def));
                     }
 
-                    return bool_args.at(name);
+                    return choice_args.at(name);
                 }
             }
             else
             {
                 static_assert(
-                    false,
+                    value_traits<T>::kind == value::CUSTOM,
                     "Invalid type"
                 );
 
-                // Unreachable code
-                return (T){0};
-            }
-        }
-
-    public:
-        explicit args(
-            ankerl::unordered_dense::map<
-                Celery::Str::External,
-                value,
-                Celery::Misc::Hash,
-			    Celery::Misc::StringEquality
-            > &commands,
-
-            ankerl::unordered_dense::map<
-                Celery::Str::External,
-                value,
-                Celery::Misc::Hash,
-	    		Celery::Misc::StringEquality
-            > &flags,
-
-            // Aliases (cmd name -> alias)
-            ankerl::unordered_dense::map<
-                Celery::Str::External,
-                Celery::Str::External,
-                Celery::Misc::Hash,
-			    Celery::Misc::StringEquality
-            > &cmd_aliases,
-
+                const auto &custom = std::is_same_v<Flag, bool> ? custom_flags : custom_args;
+                if (const auto it = custom.find(name); it != custom.end())
+                {
+                    return value::unwrap<T>(it->second);
+                }
 
-            ankerl::unordered_dense::map<
-                Celery::Str::External,
-                Celery::Str::External,
-                Celery::Misc::Hash,
-			    Celery::Misc::StringEquality
-            > &flag_aliases,
+                // Return default value
+                const value &def = std::is_same_v<Flag, bool>
+                    ? schema_.flag(name)
+                    : schema_.command(name);
 
-            // Aliases (alias -> cmd name)
-            ankerl::unordered_dense::map<
-                Celery::Str::External,
-                Celery::Str::External,
-                Celery::Misc::Hash,
-			    Celery::Misc::StringEquality
-            > &cmd_aliases_reverse,
+                return def.get<T>(schema_.default_of(def));
+            }
+        }
 
-            ankerl::unordered_dense::map<
-                Celery::Str::External,
-                Celery::Str::External,
-                Celery::Misc::Hash,
-			    Celery::Misc::StringEquality
-            > &flag_aliases_reverse
-        ) :
-            commands(commands),
-            flags(flags),
-            cmd_aliases(cmd_aliases),
-            flag_aliases(flag_aliases),
-            cmd_aliases_reverse(cmd_aliases_reverse),
-            flag_aliases_reverse(flag_aliases_reverse)
-        {}
+        /**
+         * @brief Starts from a clean slate, the same object may parse many vectors.
+         */
+        void reset(void *target)
+        {
+            global_error = error();
+            object = target;
+
+            str_args.clear();
+            int_args.clear();
+            float_args.clear();
+            bool_args.clear();
+            choice_args.clear();
+            str_flags.clear();
+            int_flags.clear();
+            float_flags.clear();
+            bool_flags.clear();
+            choice_flags.clear();
+            custom_args.clear();
+            custom_flags.clear();
+            pending_args.clear();
+            pending_flags.clear();
+            flag_sources.clear();
+            bound_texts.clear();
+
+            cmd = Celery::Str::External();
+            cmd_slot = SIZE_MAX;
+            passthrough_args = argv_view();
+
+            positional_args.assign(schema_.positionals.size(), argv_view());
+            occurrence_log.clear();
+            config_strings.clear();
+            seen.clear();
+            slot_pos.assign(schema_.slots, 0);
+            paths.clear();
+            path_jobs.clear();
+        }
 
-        bool parse(
-            const int argc,
-            const char **argv
-        )
+        /**
+         * @brief Appends an event to the occurrences, values go with their command or flag.
+         */
+        void log(const event &ev)
         {
-            if (argc < 2 || argv == nullptr)
+            switch (ev.event_type)
             {
-                global_error.argv_pos = 0;
-                global_error.error_type = error::EXPECTED_VALUE;
-                return false;
+                case event::COMMAND:
+                case event::FLAG:
+                    occurrence_log.push_back(occurrence{
+                        static_cast<uint32_t>(ev.slot),
+                        static_cast<uint32_t>(ev.argv_pos),
+                        Celery::Str::External("", 0),
+                        false
+                    });
+                    break;
+
+                case event::VALUE:
+                    occurrence_log.back().text = ev.text;
+                    break;
+
+                case event::POSITIONAL:
+                    occurrence_log.push_back(occurrence{
+                        static_cast<uint32_t>(ev.slot),
+                        static_cast<uint32_t>(ev.argv_pos),
+                        ev.text,
+                        true
+                    });
+                    break;
+
+                default:
+                    break;
             }
+        }
 
-            // Whether we are waiting for a value
-            bool waiting_value = false;
-            bool value_command = false; ///< Whether the expected value is for a command
-            bool has_command = false;
-            value::type expected;
-            Celery::Str::External flag("", 0);
-            for (int i = 1; i < argc; ++i)
+        /**
+         * @brief Applies one event of the reader.
+         */
+        bool apply(event &ev, const char **argv, const size_t *lens)
+        {
+            log(ev);
+            switch (ev.event_type)
             {
-                const auto arg = argv[i];
-                if (waiting_value)
+                case event::COMMAND:
                 {
-                    auto val = Celery::Str::External(arg);
-                    bool parsing_success = false;
+                    cmd = ev.name;
+                    cmd_slot = ev.slot;
 
-                    if (value_command)
+                    mark(ev.slot, ev.argv_pos);
+                    if (ev.val->get_type() == value::BOOL)
                     {
-                        switch (expected)
-                        {
-                            case value::BOOL:
-                            {
-                                parsing_success = parse_value<bool, int>(
-                                    val,
-                                    cmd
-                                );
-
-                                break;
-                            }
-
-                            case value::FLOAT:
-                            {
-                                parsing_success = parse_value<float, int>(
-                                    val,
-                                    cmd
-                                );
-
-                                break;
-                            }
-
-                            case value::INTEGER:
-                            {
-                                parsing_success = parse_value<int, int>(
-                                    val,
-                                    cmd
-                                );
-
-                                break;
-                            }
-
-                            case value::STRING:
-                            {
-                                parsing_success = parse_value<Celery::Str::External, int>(
-                                    val,
-                                    cmd
-                                );
-
-                                break;
-                            }
-                        }
+                        bool_args[cmd] = ev.val->get<bool>(schema_.default_of(*ev.val));
                     }
-                    else
+
+                    // Flags of the command are only registered now, which
+                    // may move every value in the schema
+                    schema_.load(cmd);
+                    ev.val = nullptr;
+                    break;
+                }
+
+                case event::FLAG:
+                {
+                    mark(ev.val->get_slot(), ev.argv_pos);
+                    if (ev.val->get_type() == value::BOOL)
                     {
-                        switch (expected)
+                        if (const auto *dest = bound(*ev.val))
+                        {
+                            const Celery::Str::External enabled("true", 4);
+                            write_bound(*dest, *ev.val, &enabled);
+                            bound_texts[ev.name] = enabled;
+                        }
+                        else
                         {
-                            case value::BOOL:
-                            {
-                                parsing_success = parse_value<bool, bool>(
-                                    val,
-                                    flag
-                                );
-
-                                break;
-                            }
-
-                            case value::FLOAT:
-                            {
-                                parsing_success = parse_value<float, bool>(
-                                    val,
-                                    flag
-                                );
-
-                                break;
-                            }
-
-                            case value::INTEGER:
-                            {
-                                parsing_success = parse_value<int, bool>(
-                                    val,
-                                    flag
-                                );
-
-                                break;
-                            }
-
-                            case value::STRING:
-                            {
-                                parsing_success = parse_value<Celery::Str::External, bool>(
-                                    val,
-                                    flag
-                                );
-
-                                break;
-                            }
+                            bool_flags[ev.name] = true;
                         }
                     }
 
+                    break;
+                }
+
+                case event::VALUE:
+                {
+                    const auto type = ev.val->get_type();
+                    const auto error_type = type == value::CHOICE
+                        ? error::INVALID_CHOICE
+                        : error::TYPE_MISMATCH;
+
+                    if (type == value::STRING && !check_text(ev.text, ev.argv_pos, ev.name))
+                    {
+                        return false;
+                    }
+
+                    const bool parsing_success = ev.command
+                        ? store<int>(*ev.val, ev.text, ev.name, ev.argv_pos, error_type, ev.name)
+                        : store<bool>(*ev.val, ev.text, ev.name, ev.argv_pos, error_type, ev.name);
+
                     if (!parsing_success)
                     {
-                        global_error.error_type = error::TYPE_MISMATCH;
-                        global_error.argv_pos = i;
+                        global_error.error_type = error_type;
+                        global_error.argv_pos = ev.argv_pos;
+                        global_error.source = ev.name;
                         return false;
                     }
 
-                    waiting_value = false;
-                    value_command = false; // Reset the command value expectation
-                    continue;
+                    queue_path(ev.val->get_slot(), ev.text, ev.argv_pos, ev.name);
+                    break;
                 }
 
-                // Check if we have a flag
-                if (arg[0] == '-')
+                case event::DEFAULT:
                 {
-                    // Check if the flag is valid
-                    if (arg[1] == '\0')
+                    if (const auto *dest = bound(*ev.val))
                     {
-                        global_error.error_type = error::UNKNOWN_FLAG;
-                        global_error.argv_pos = i;
-                        return false;
+                        write_bound(*dest, *ev.val, nullptr);
+                        break;
                     }
 
-                    // Check if we have a long flag
-                    if (arg[1] == '-')
+                    store_default(*ev.val, ev.name, ev.command);
+                    break;
+                }
+
+                case event::POSITIONAL:
+                {
+                    if (!check_text(ev.text, ev.argv_pos, ev.name))
                     {
-                        // Make sure we have a name
-                        if (arg[2] == '\0')
-                        {
-                            global_error.error_type = error::EXPECTED_VALUE;
-                            global_error.argv_pos = i;
-                        }
+                        return false;
+                    }
 
-                        flag = Celery::Str::External(arg + 2);
+                    auto &view = positional_args[ev.slot];
+                    if (view.empty())
+                    {
+                        view = argv_view(
+                            argv + ev.argv_pos,
+                            argv + ev.argv_pos + 1,
+                            ev.argv_pos,
+                            lens == nullptr ? nullptr : lens + ev.argv_pos
+                        );
                     }
                     else
                     {
-                        flag = Celery::Str::External(arg + 1);
+                        // The reader guarantees variadic runs are contiguous
+                        view.grow();
                     }
 
-                    // Check if we have a value
-                    const auto flag_ptr = flag.Ptr();
                     if (
-                        const auto equals = strchr(flag_ptr, '=');
-                        equals != nullptr
+                        ev.slot < schema_.positional_paths.size()
+                        && schema_.positional_paths[ev.slot] != path_check::NONE
                     )
                     {
-                        // Find the position of the equals sign
-                        const size_t equals_pos = equals - flag.Ptr();
-                        const auto value = flag_ptr + equals_pos + 1; // Skip the equals sign
-
-                        flag = Celery::Str::External(flag.Ptr(), equals_pos); // Exclude the equals sign
+                        paths.add(ev.text, schema_.positional_paths[ev.slot], ev.argv_pos, ev.name);
+                    }
 
-                        if (!parse_flag(flag, waiting_value, expected, i))
-                        {
-                            return false;
-                        }
+                    break;
+                }
 
-                        // Check if we are expecting a value
-                        if (!waiting_value)
-                        {
-                            global_error.error_type = error::NOT_EXPECTED_VALUE;
-                            global_error.argv_pos = i;
-                            return false;
-                        }
+                case event::PASSTHROUGH:
+                {
+                    passthrough_args = ev.rest;
+                    break;
+                }
 
-                        // Validate the value
-                        if (value[0] == '\0')
-                        {
-                            global_error.error_type = error::EXPECTED_VALUE;
-                            global_error.argv_pos = i;
-                            return false;
-                        }
+                case event::SEPARATOR:
+                    break; // Ends the loop in `read()`
 
-                        auto val = Celery::Str::External(value);
-                        waiting_value = false; // We are no longer waiting for a value
-                        bool parsing_success = false;
+                case event::ERROR:
+                {
+                    global_error.error_type = ev.error_type;
+                    global_error.argv_pos = ev.argv_pos;
+                    global_error.source = ev.name;
+                    return false;
+                }
+            }
 
-                        // Parse the value
-                        switch (expected)
-                        {
-                            case value::BOOL:
-                            {
-                                parsing_success = parse_value<bool, bool>(
-                                    val,
-                                    flag
-                                );
-
-                                break;
-                            }
-
-                            case value::FLOAT:
-                            {
-                                parsing_success = parse_value<float, bool>(
-                                    val,
-                                    flag
-                                );
-
-                                break;
-                            }
-
-                            case value::INTEGER:
-                            {
-                                parsing_success = parse_value<int, bool>(
-                                    val,
-                                    flag
-                                );
-
-                                break;
-                            }
-
-                            case value::STRING:
-                            {
-                                parsing_success = parse_value<Celery::Str::External, bool>(
-                                    val,
-                                    flag
-                                );
-
-                                break;
-                            }
-                        }
+            return true;
+        }
 
-                        if (!parsing_success)
-                        {
-                            global_error.error_type = error::TYPE_MISMATCH;
-                            global_error.argv_pos = i;
-                            return false;
-                        }
+        /**
+         * @brief Consumes the events of a reader, then merges the other sources.
+         */
+        bool read(reader &tokens)
+        {
+            const auto argv = tokens.get_argv();
+            const auto lens = tokens.get_lens();
 
-                        continue;
-                    }
+            event ev;
+            while (true)
+            {
+                // Tokens are only checkpointed once, the first time the reader gets to them
+                if (
+                    journaling
+                    && tokens.between_tokens()
+                    && static_cast<size_t>(tokens.position()) == marks.size() + 1
+                )
+                {
+                    marks.push_back(token_mark{tokens.save(), steps.size()});
+                }
 
-                    // Parse the flag
-                    if (!parse_flag(flag, waiting_value, expected, i))
-                    {
-                        return false;
-                    }
+                if (!tokens.next(ev) || ev.event_type == event::SEPARATOR)
+                {
+                    break;
+                }
 
-                    continue;
+                if (!apply(ev, argv, lens))
+                {
+                    return false;
                 }
 
-                // Parse commands
-                if (!has_command)
+                if (journaling)
                 {
-                    cmd = Celery::Str::External(arg);
-                    has_command = true;
+                    record(ev, argv);
+                }
+            }
 
-                    // Handle aliases
-                    if (cmd_aliases_reverse.contains(cmd))
-                    {
-                        const auto &alias = cmd_aliases_reverse.at(cmd);
-                        cmd = alias;
-                    }
+            // Fall back to the environment and then to the
+            // configuration file for flags not given in argv
+            if (!parse_env() || !parse_config())
+            {
+                return false;
+            }
 
-                    // Check if the command is valid
-                    if (commands.contains(cmd))
-                    {
-                        const auto &cmd_it = commands.find(cmd);
-                        const auto &cmd_val = cmd_it->second;
+            // Only then check constraints against everything that was given
+            write_defaults();
+            return check_constraints() && check_paths();
+        }
 
-                        // Modify cmd to the original ptr
-                        cmd = cmd_it->first;
-                        waiting_value = cmd_val.get_type() != value::BOOL;
-                        expected = cmd_val.get_type();
+        /**
+         * @brief Journals an applied event, along with its converted value.
+         */
+        void record(const event &ev, const char **argv)
+        {
+            step applied;
+            applied.ev = ev;
 
-                        if (!waiting_value)
-                        {
-                            bool_args[cmd] = cmd_val.get<bool>();
-                        }
-                        else
-                        {
-                            value_command = true; // We are expecting a value for the command
-                        }
-                    }
-                    else
-                    {
-                        global_error.error_type = error::UNKNOWN_COMMAND;
-                        global_error.argv_pos = i;
-                        return false;
-                    }
+            if (ev.event_type == event::VALUE || ev.event_type == event::POSITIONAL)
+            {
+                // Texts are slices of argv, which is not kept
+                applied.text_offset = ev.text.Ptr() - argv[ev.argv_pos];
+            }
 
-                    continue;
-                }
+            // Strings and user types may hold slices of argv, so only those are converted again
+            const auto type = ev.val != nullptr ? ev.val->get_type() : value::STRING;
+            if (
+                ev.event_type == event::VALUE
+                && !lazy
+                && bound(*ev.val) == nullptr
+                && type != value::STRING
+                && type != value::CUSTOM
+            )
+            {
+                applied.converted = true;
+                applied.stored = take(*ev.val, ev.name, ev.command);
+            }
 
-                // Invalid argument
-                global_error.error_type = error::NOT_EXPECTED_VALUE;
-                global_error.argv_pos = i;
-                return false;
+            // Looked up again on replay, see `relink()`
+            applied.ev.val = nullptr;
+            steps.push_back(applied);
+        }
+
+        /**
+         * @brief Looks up the registered value of a journaled event again.
+         */
+        void relink(event &ev) const
+        {
+            switch (ev.event_type)
+            {
+                case event::COMMAND:
+                case event::FLAG:
+                case event::VALUE:
+                case event::DEFAULT:
+                    ev.val = ev.command || ev.event_type == event::COMMAND
+                        ? &schema_.command(ev.name)
+                        : &schema_.flag(ev.name);
+                    break;
+
+                default:
+                    break;
             }
+        }
+
+        /**
+         * @brief Applies a journaled event to a new argv, skipping its conversion.
+         */
+        bool replay(const step &applied, const char **argv, const size_t *lens)
+        {
+            event ev = applied.ev;
+            relink(ev);
 
-            // Make sure we are not waiting for a value
-            if (!has_command)
+            if (ev.event_type == event::VALUE || ev.event_type == event::POSITIONAL)
             {
-                global_error.error_type = error::EXPECTED_VALUE;
-                global_error.argv_pos = argc - 1;
-                return false;
+                ev.text = Celery::Str::External(argv[ev.argv_pos] + applied.text_offset, ev.text.Size());
             }
 
-            // Default values if we are still expecting a value
-            if (waiting_value)
+            if (!applied.converted)
             {
-                // Retrieve the value
-                const value &val = value_command
-                    ? commands.at(cmd)
-                    : flags.at(flag);
+                return apply(ev, argv, lens);
+            }
+
+            log(ev);
+            put(*ev.val, ev.name, ev.command, applied.stored);
+            queue_path(ev.val->get_slot(), ev.text, ev.argv_pos, ev.name);
+            return true;
+        }
 
+        /**
+         * @brief Copies the tokens of a new argv, to spot edits on the next one.
+         * @return The position of the first token that changed.
+         */
+        size_t remember(const int argc, const char **argv, const size_t *lens)
+        {
+            size_t first = 1;
+            while (first <= token_ends.size() && first < static_cast<size_t>(argc))
+            {
+                const size_t begin = first == 1 ? 0 : token_ends[first - 2];
+                const size_t size = token_ends[first - 1] - begin;
+                const size_t len = lens == nullptr ? strlen(argv[first]) : lens[first];
 
-                switch (val.get_type())
+                if (len != size || memcmp(argv[first], token_text.data() + begin, size) != 0)
                 {
-                    case value::STRING:
-                    {
-                        if (value_command)
-                        {
-                            str_args[cmd] = val.get<Celery::Str::External>();
-                        }
-                        else
-                        {
-                            str_flags[flag] = val.get<Celery::Str::External>();
-                        }
-                    }
+                    break;
+                }
 
-                    case value::BOOL:
-                    {
-                        if (value_command)
-                        {
-                            bool_args[cmd] = val.get<bool>();
-                        }
-                        else
-                        {
-                            bool_flags[flag] = val.get<bool>();
-                        }
-                    }
+                ++first;
+            }
 
-                    case value::FLOAT:
-                    {
-                        if (value_command)
-                        {
-                            float_args[cmd] = val.get<float>();
-                        }
-                        else
-                        {
-                            float_flags[flag] = val.get<float>();
-                        }
-                    }
+            token_ends.resize(first - 1);
+            token_text.resize(token_ends.empty() ? 0 : token_ends.back());
 
-                    case value::INTEGER:
-                    {
-                        if (value_command)
-                        {
-                            int_args[cmd] = val.get<int>();
-                        }
-                        else
-                        {
-                            int_flags[flag] = val.get<int>();
-                        }
-                    }
+            for (size_t pos = first; pos < static_cast<size_t>(argc); ++pos)
+            {
+                const size_t len = lens == nullptr ? strlen(argv[pos]) : lens[pos];
+                token_text.insert(token_text.end(), argv[pos], argv[pos] + len);
+                token_ends.push_back(token_text.size());
+            }
+
+            return first;
+        }
+
+    public:
+        /**
+         * @brief Constructs the arguments for the given schema.
+         * @param schema_ The schema to parse against.
+         * @param lazy Whether to defer conversions until values are read.
+         *             Type errors are then reported on access, through
+         *             the global error object.
+         */
+        explicit args(schema &schema_, const bool lazy = false) :
+            schema_(schema_), lazy(lazy)
+        {}
+
+        /**
+         * @brief Parses an argument vector.
+         * @param argc The number of arguments.
+         * @param argv The arguments, null-terminated.
+         * @param lens The length of each argument, if already known. Passing
+         *             them avoids all `strlen()` calls during parsing.
+         * @param target The object member bindings are written into.
+         */
+        bool parse(
+            const int argc,
+            const char **argv,
+            const size_t *lens = nullptr,
+            void *target = nullptr
+        )
+        {
+            reader tokens(schema_, argc, argv, lens);
+            return parse(tokens, target);
+        }
+
+        /**
+         * @brief Parses the next command of a reader.
+         *
+         * Stops at the end of argv or, for chained command lines, right
+         * after the delimiter, so the next command can be parsed from
+         * the same reader; see `reader::chain()`.
+         *
+         * @param tokens The reader to consume events from.
+         * @param target The object member bindings are written into.
+         */
+        bool parse(reader &tokens, void *target = nullptr)
+        {
+            if (schema_.bound_type != nullptr && target == nullptr)
+            {
+                throw Celery::Except::Exception("Member bindings need a target object");
+            }
+
+            reset(target);
+            return read(tokens);
+        }
+
+        /**
+         * @brief Parses an edited version of the last argument vector.
+         *
+         * Meant for callers that validate a command line as it is being
+         * typed. Parses are journaled, so only the tokens from the first
+         * one that changed are read again: lookups and conversions done
+         * for the unchanged tokens before it are replayed from the
+         * journal. The first call parses the whole vector.
+         *
+         * @param argc The number of arguments.
+         * @param argv The arguments, null-terminated.
+         * @param lens The length of each argument, if already known.
+         * @param target The object member bindings are written into.
+         */
+        bool reparse(
+            const int argc,
+            const char **argv,
+            const size_t *lens = nullptr,
+            void *target = nullptr
+        )
+        {
+            if (schema_.bound_type != nullptr && target == nullptr)
+            {
+                throw Celery::Except::Exception("Member bindings need a target object");
+            }
+
+            const size_t first = remember(argc, argv, lens);
+            const size_t resume = std::min(first, marks.size());
+
+            reader tokens(schema_, argc, argv, lens);
+            reset(target);
+
+            if (!journaling || resume == 0)
+            {
+                journaling = true;
+                steps.clear();
+                marks.clear();
+                return read(tokens);
+            }
+
+            const auto point = marks[resume - 1];
+            steps.resize(point.steps);
+            marks.resize(resume - 1); // Taken again as the reader gets there
+
+            for (const auto &applied : steps)
+            {
+                if (!replay(applied, argv, lens))
+                {
+                    return false;
                 }
             }
 
-            return true;
+            event waiting_for;
+            if (point.point.waiting_value)
+            {
+                waiting_for = steps.back().ev;
+                relink(waiting_for);
+            }
+
+            tokens.restore(point.point, waiting_for);
+            return read(tokens);
         }
 
+        /**
+         * @brief Gets the value of a flag, or its default if it was not given.
+         *
+         * In lazy mode the value is converted here, so check `is_err()`
+         * after each access: a value that fails to convert yields the
+         * default, and reports its error again on every access.
+         *
+         * @param name The name of the flag.
+         */
         template <typename T>
         T flag(const Celery::Str::External &name)
         {
@@ -882,6 +1525,14 @@ namespace zelix::cli
             return val<T, bool>(Celery::Str::External(name));
         }
 
+        /**
+         * @brief Gets the value of a command, or its default if it was not given.
+         *
+         * Like `flag()`, lazy conversions fail on each access, so check
+         * `is_err()` after each one.
+         *
+         * @param name The name of the command.
+         */
         template <typename T>
         T command(const Celery::Str::External &name)
         {
@@ -894,13 +1545,155 @@ namespace zelix::cli
             return val<T, int>(Celery::Str::External(name));
         }
 
+        /**
+         * @brief Gets the arguments passed to a positional.
+         *
+         * The returned view points directly into argv, no arguments
+         * are copied. Non-variadic positionals yield at most one element.
+         *
+         * @param name The name of the positional.
+         */
+        [[nodiscard]] const argv_view &positional(const Celery::Str::External &name) const
+        {
+            return positional_args[schema_.positional(name)];
+        }
+
+        [[nodiscard]] const argv_view &positional(const char *name) const
+        {
+            return positional(Celery::Str::External(name));
+        }
+
+        /**
+         * @brief Gets the arguments that follow the "--" terminator.
+         *
+         * The view points directly into argv and, since argv is
+         * null-terminated, `passthrough().begin()` can be passed
+         * as-is to `execv()` and friends.
+         */
+        [[nodiscard]] const argv_view &passthrough() const
+        {
+            return passthrough_args;
+        }
+
+        /**
+         * @brief Gets every command, flag and positional given in argv, in order.
+         *
+         * Each entry carries the value given with it, so tools whose
+         * semantics depend on ordering (e.g. `--whole-archive a.o
+         * --no-whole-archive b.o`, or include paths) can walk it instead
+         * of scanning argv again. Values from the environment, the
+         * configuration file and defaults are not included; neither is
+         * anything after the "--" terminator.
+         *
+         * ```c++
+         * for (const cli::occurrence &occ : args.occurrences())
+         * {
+         *     if (!occ.positional && occ.slot == whole_archive) ...
+         * }
+         * ```
+         */
+        [[nodiscard]] std::span<const occurrence> occurrences() const
+        {
+            return occurrence_log;
+        }
+
+        /**
+         * @brief Serializes the parse results into a flat, relocatable buffer.
+         *
+         * The buffer holds a fingerprint of the schema, the value of every
+         * command and flag that was set, and a string pool with string
+         * values, positionals and passthrough arguments. Another process
+         * or thread can read it through `args_view::from_bytes()` without
+         * re-parsing argv. In lazy mode, unconverted values are stored as
+         * strings and converted on access; so are the values written into
+         * bound flags.
+         */
+        [[nodiscard]] std::vector<unsigned char> serialize() const
+        {
+            blob::writer out(schema_.fingerprint(), schema_.slots);
+            if (cmd.Size() != 0)
+            {
+                out.set_command(schema_.command(cmd).get_slot());
+            }
+
+            serialize_map(out, str_args, true);
+            serialize_map(out, int_args, true);
+            serialize_map(out, float_args, true);
+            serialize_map(out, bool_args, true);
+            serialize_map(out, choice_args, true);
+            serialize_map(out, custom_args, true);
+            serialize_map(out, str_flags, false);
+            serialize_map(out, int_flags, false);
+            serialize_map(out, float_flags, false);
+            serialize_map(out, bool_flags, false);
+            serialize_map(out, choice_flags, false);
+            serialize_map(out, custom_flags, false);
+
+            // Values waiting to be converted travel as strings
+            for (const auto &[name, pending] : pending_args)
+            {
+                out.add(schema_.command(name).get_slot(), true, ARGV, pending.value, true);
+            }
+
+            for (const auto &[name, pending] : pending_flags)
+            {
+                const auto src = flag_sources.find(name);
+                out.add(
+                    schema_.flag(name).get_slot(),
+                    false,
+                    src == flag_sources.end() ? ARGV : src->second,
+                    pending.value,
+                    true
+                );
+            }
+
+            // So do bound flags, whose values only live in their variables
+            for (const auto &[name, text] : bound_texts)
+            {
+                const auto src = flag_sources.find(name);
+                out.add(
+                    schema_.flag(name).get_slot(),
+                    false,
+                    src == flag_sources.end() ? ARGV : src->second,
+                    text,
+                    true
+                );
+            }
+
+            for (size_t i = 0; i < schema_.positionals.size(); ++i)
+            {
+                out.add_list(i < positional_args.size() ? positional_args[i] : argv_view());
+            }
+
+            out.add_list(passthrough_args);
+            return out.finish();
+        }
+
+        /**
+         * @brief Gets where the value of a flag came from.
+         * @param name The name of the flag.
+         */
+        [[nodiscard]] source source_of(const Celery::Str::External &name) const
+        {
+            if (const auto it = flag_sources.find(name); it != flag_sources.end())
+            {
+                return it->second;
+            }
+
+            return seen.test(schema_.flag(name).get_slot()) ? ARGV : DEFAULT;
+        }
+
+        [[nodiscard]] source source_of(const char *name) const
+        {
+            return source_of(Celery::Str::External(name));
+        }
+
         Celery::Str::External &get_cmd()
         {
             return this->cmd;
         }
 
         [[nodiscard]] static bool is_err()
-
         {
             return global_error.error_type != error::UNKNOWN;
         }
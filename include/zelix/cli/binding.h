@@ -0,0 +1,151 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/17/25.
+//
+
+#pragma once
+#include "celery/string/external.h"
+#include "traits.h"
+#include "value.h"
+
+namespace zelix::cli
+{
+    /**
+     * @brief Destination a flag is converted straight into.
+     *
+     * Bound flags never reach the typed maps in `args`; their values
+     * are written through `write` as soon as they are parsed.
+     */
+    class binding
+    {
+        template <typename T>
+        static bool assign(
+            T &out,
+            const value &val,
+            const value::storage &base,
+            const Celery::Str::External *text
+        )
+        {
+            // Only touch the destination once the conversion succeeded
+            T result = val.get<T>(base);
+            if (text != nullptr && !value_traits<T>::parse(*text, result))
+            {
+                return false;
+            }
+
+            out = result;
+            return true;
+        }
+
+        template <typename M>
+        struct member_of;
+
+        template <typename C, typename T>
+        struct member_of<T C::*>
+        {
+            using owner = C;
+            using type = T;
+        };
+
+    public:
+        /**
+         * @brief Writes a value into a destination.
+         * @param target The variable, or the object for member bindings.
+         * @param val The registered value, used for its type and choices.
+         * @param base The value conversions start from, or the default to write.
+         * @param text The text to convert, or `nullptr` to write `base`.
+         * @return Whether the conversion succeeded.
+         */
+        using writer = bool (*)(
+            void *target,
+            const value &val,
+            const value::storage &base,
+            const Celery::Str::External *text
+        );
+
+        void *target = nullptr; ///< Bound variable, `nullptr` for members
+        writer write = nullptr; ///< `nullptr` when the slot is not bound
+        bool c_string = false; ///< Whether the destination keeps a pointer to the text, which must then be null-terminated
+
+        template <typename M>
+        using owner_of = typename member_of<M>::owner;
+
+        template <typename M>
+        using field_of = typename member_of<M>::type;
+
+        /**
+         * @brief Identifies a class without RTTI.
+         */
+        template <typename C>
+        static const void *tag()
+        {
+            static constexpr char id = 0;
+            return &id;
+        }
+
+        template <typename T>
+        static binding variable(T *dest)
+        {
+            binding result;
+            result.target = dest;
+            result.write = [](
+                void *target,
+                const value &val,
+                const value::storage &base,
+                const Celery::Str::External *text
+            )
+            {
+                return assign(*static_cast<T *>(target), val, base, text);
+            };
+
+            result.c_string = std::is_same_v<T, const char *>;
+
+            return result;
+        }
+
+        template <auto Member>
+        static binding member()
+        {
+            using owner = owner_of<decltype(Member)>;
+
+            binding result;
+            result.write = [](
+                void *target,
+                const value &val,
+                const value::storage &base,
+                const Celery::Str::External *text
+            )
+            {
+                return assign(static_cast<owner *>(target)->*Member, val, base, text);
+            };
+
+            result.c_string = std::is_same_v<field_of<decltype(Member)>, const char *>;
+
+            return result;
+        }
+    };
+}
@@ -0,0 +1,142 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/16/25.
+//
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace zelix::cli
+{
+    /**
+     * @brief Growable set of slot ids, stored as a bitmask.
+     *
+     * Schemas rarely have more than 64 commands and flags, so most
+     * operations boil down to a single AND and compare.
+     */
+    class slot_set
+    {
+        std::vector<uint64_t> words;
+
+        [[nodiscard]] uint64_t word(const size_t i) const
+        {
+            return i < words.size() ? words[i] : 0;
+        }
+
+    public:
+        void set(const size_t slot)
+        {
+            const size_t i = slot / 64;
+            if (i >= words.size())
+            {
+                words.resize(i + 1, 0);
+            }
+
+            words[i] |= uint64_t{1} << (slot % 64);
+        }
+
+        [[nodiscard]] bool test(const size_t slot) const
+        {
+            return (word(slot / 64) >> (slot % 64)) & 1;
+        }
+
+        void clear()
+        {
+            std::fill(words.begin(), words.end(), 0);
+        }
+
+        [[nodiscard]] bool empty() const
+        {
+            for (const auto w : words)
+            {
+                if (w != 0)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        /**
+         * @brief Checks whether every slot in `other` is also in this set.
+         */
+        [[nodiscard]] bool contains_all(const slot_set &other) const
+        {
+            for (size_t i = 0; i < other.words.size(); ++i)
+            {
+                if ((word(i) & other.words[i]) != other.words[i])
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        /**
+         * @brief Counts the slots present in both sets.
+         */
+        [[nodiscard]] size_t count_common(const slot_set &other) const
+        {
+            size_t count = 0;
+            for (size_t i = 0; i < other.words.size(); ++i)
+            {
+                count += __builtin_popcountll(word(i) & other.words[i]);
+            }
+
+            return count;
+        }
+
+        /**
+         * @brief Finds the first slot of `other` that is not in this set.
+         * @param from The first slot to look at.
+         * @return The slot, or `SIZE_MAX` if there is none.
+         */
+        [[nodiscard]] size_t first_missing(const slot_set &other, const size_t from = 0) const
+        {
+            for (size_t i = from / 64; i < other.words.size(); ++i)
+            {
+                uint64_t missing = other.words[i] & ~word(i);
+                if (i == from / 64)
+                {
+                    missing &= ~uint64_t{0} << (from % 64);
+                }
+
+                if (missing != 0)
+                {
+                    return i * 64 + __builtin_ctzll(missing);
+                }
+            }
+
+            return SIZE_MAX;
+        }
+    };
+}
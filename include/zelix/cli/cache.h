@@ -0,0 +1,255 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/21/25.
+//
+
+#pragma once
+#include <atomic>
+#include <cstring>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "ankerl/unordered_dense.h"
+#include "args.h"
+#include "hash.h"
+#include "schema.h"
+#include "serialize.h"
+
+namespace zelix::cli
+{
+    /**
+     * @brief Bounded, thread-safe cache of parse results.
+     *
+     * Results are keyed by a hash of the argv contents and kept in
+     * their serialized form, so a hit hands out a shared, immutable
+     * `args_view` that owns everything it points to. Only successful
+     * parses are cached.
+     *
+     * Parsing on a miss happens outside the lock, so apps with flags
+     * bound to variables or members are rejected: concurrent misses
+     * would all write the same destinations. Commands with flag
+     * registrars must be loaded up front (`app::load()`) when the
+     * cache is used from many threads.
+     */
+    class parse_cache
+    {
+        /**
+         * @brief A cached result, along with the command line it came from.
+         */
+        class entry
+        {
+        public:
+            std::vector<unsigned char> bytes; ///< Serialized result
+            args_view view; ///< View over `bytes`
+        };
+
+        class node
+        {
+        public:
+            uint64_t key = 0;
+            std::vector<char> line; ///< Every argument, NUL-terminated, to rule out collisions
+            std::shared_ptr<const entry> result;
+        };
+
+        schema &schema_;
+        size_t capacity;
+
+        std::mutex lock;
+        std::list<node> order; ///< Most recently used first
+        ankerl::unordered_dense::map<uint64_t, std::list<node>::iterator> index;
+
+        std::atomic<uint64_t> hit_count{0};
+        std::atomic<uint64_t> miss_count{0};
+
+        static size_t length(const char **argv, const size_t *lens, const int i)
+        {
+            return lens == nullptr ? strlen(argv[i]) : lens[i];
+        }
+
+        static uint64_t hash(const int argc, const char **argv, const size_t *lens)
+        {
+            // Terminators are hashed too, so {"ab", "c"} and {"a", "bc"} differ
+            fnv1a result;
+            for (int i = 0; i < argc; ++i)
+            {
+                result.update(argv[i], length(argv, lens, i) + 1);
+            }
+
+            return result.digest();
+        }
+
+        static bool same(
+            const std::vector<char> &line,
+            const int argc,
+            const char **argv,
+            const size_t *lens
+        )
+        {
+            size_t offset = 0;
+            for (int i = 0; i < argc; ++i)
+            {
+                const size_t size = length(argv, lens, i) + 1;
+                if (offset + size > line.size() || memcmp(line.data() + offset, argv[i], size) != 0)
+                {
+                    return false;
+                }
+
+                offset += size;
+            }
+
+            return offset == line.size();
+        }
+
+        void check_unbound() const
+        {
+            // Bindings are only ever added through `app::bind()`, which sizes the table
+            if (!schema_.bindings.empty())
+            {
+                throw Celery::Except::Exception("Apps with bound flags cannot be cached");
+            }
+        }
+
+        static std::vector<char> flatten(const int argc, const char **argv, const size_t *lens)
+        {
+            std::vector<char> line;
+            for (int i = 0; i < argc; ++i)
+            {
+                line.insert(line.end(), argv[i], argv[i] + length(argv, lens, i) + 1);
+            }
+
+            return line;
+        }
+
+    public:
+        /**
+         * @param schema_ The schema to parse against.
+         * @param capacity The maximum number of results to keep.
+         */
+        explicit parse_cache(schema &schema_, const size_t capacity) :
+            schema_(schema_), capacity(capacity)
+        {
+            if (capacity == 0)
+            {
+                throw Celery::Except::Exception("Cache capacity cannot be zero");
+            }
+
+            check_unbound();
+        }
+
+        parse_cache(const parse_cache &) = delete;
+        parse_cache &operator=(const parse_cache &) = delete;
+
+        /**
+         * @brief Parses an argument vector, or returns its cached result.
+         * @param argc The number of arguments.
+         * @param argv The arguments.
+         * @param lens The length of each argument, if already known.
+         * @return The result, or `nullptr` if parsing failed, in which
+         *         case the error is left in the global error object.
+         */
+        [[nodiscard]] std::shared_ptr<const args_view> parse(
+            const int argc,
+            const char **argv,
+            const size_t *lens = nullptr
+        )
+        {
+            const uint64_t key = hash(argc, argv, lens);
+
+            {
+                std::lock_guard guard(lock);
+                if (
+                    const auto it = index.find(key);
+                    it != index.end() && same(it->second->line, argc, argv, lens)
+                )
+                {
+                    order.splice(order.begin(), order, it->second);
+                    hit_count.fetch_add(1, std::memory_order_relaxed);
+
+                    global_error = error();
+                    const auto &result = it->second->result;
+                    return std::shared_ptr<const args_view>(result, &result->view);
+                }
+            }
+
+            miss_count.fetch_add(1, std::memory_order_relaxed);
+
+            // Flags may have been bound after the cache was made
+            check_unbound();
+
+            args parsed(schema_);
+            if (!parsed.parse(argc, argv, lens))
+            {
+                return nullptr;
+            }
+
+            auto result = std::make_shared<entry>();
+            result->bytes = parsed.serialize();
+            result->view = args_view::from_bytes(schema_, result->bytes.data(), result->bytes.size());
+
+            std::lock_guard guard(lock);
+            if (const auto it = index.find(key); it != index.end())
+            {
+                // Another thread got here first, or the key collided
+                order.erase(it->second);
+                index.erase(it);
+            }
+            else if (order.size() >= capacity)
+            {
+                index.erase(order.back().key);
+                order.pop_back();
+            }
+
+            order.push_front(node{key, flatten(argc, argv, lens), result});
+            index[key] = order.begin();
+            return std::shared_ptr<const args_view>(result, &result->view);
+        }
+
+        [[nodiscard]] uint64_t hits() const
+        {
+            return hit_count.load(std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] uint64_t misses() const
+        {
+            return miss_count.load(std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] size_t size()
+        {
+            std::lock_guard guard(lock);
+            return order.size();
+        }
+
+        void clear()
+        {
+            std::lock_guard guard(lock);
+            order.clear();
+            index.clear();
+        }
+    };
+}
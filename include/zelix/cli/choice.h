@@ -0,0 +1,159 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/14/25.
+//
+
+#pragma once
+#include <cstring>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+#include "celery/except/base.h"
+#include "celery/string/external.h"
+#include "perfect_hash.h"
+
+namespace zelix::cli
+{
+    /**
+     * @brief A fixed set of accepted strings for a choice value.
+     *
+     * Like command and flag names, the strings are not copied and must
+     * outlive the set; the set itself must outlive the app it is used in.
+     *
+     * ```c++
+     * static const cli::choice_set modes({"debug", "release", "profile"});
+     * app.flag("mode", "m", "build mode", cli::choice(modes, 0));
+     * ```
+     */
+    class choice_set
+    {
+        std::vector<Celery::Str::External> options;
+        perfect_hash lookup;
+
+    public:
+        explicit choice_set(const std::initializer_list<const char *> options)
+        {
+            for (const auto option : options)
+            {
+                this->options.emplace_back(option, strlen(option));
+            }
+
+            lookup = perfect_hash(this->options.data(), this->options.size());
+        }
+
+        explicit choice_set(const std::initializer_list<Celery::Str::External> options) :
+            options(options)
+        {
+            lookup = perfect_hash(this->options.data(), this->options.size());
+        }
+
+        explicit choice_set(std::vector<Celery::Str::External> options) :
+            options(std::move(options))
+        {
+            lookup = perfect_hash(this->options.data(), this->options.size());
+        }
+
+        choice_set(const choice_set &) = delete;
+        choice_set &operator=(const choice_set &) = delete;
+
+        [[nodiscard]] size_t size() const
+        {
+            return options.size();
+        }
+
+        [[nodiscard]] const Celery::Str::External &operator[](const size_t id) const
+        {
+            return options[id];
+        }
+
+        /**
+         * @brief Resolves a string to its id.
+         * @return The id, or `perfect_hash::NONE` if it is not a valid choice.
+         */
+        [[nodiscard]] size_t find(const Celery::Str::External &option) const
+        {
+            return lookup.find(option);
+        }
+    };
+
+    /**
+     * @brief One option out of a `choice_set`, stored as its integer id.
+     */
+    class choice
+    {
+        const choice_set *set_ = nullptr;
+        size_t id_ = 0;
+
+    public:
+        explicit choice() = default;
+
+        explicit choice(const choice_set &set, const size_t id) :
+            set_(&set), id_(id)
+        {
+            if (id >= set.size())
+            {
+                throw Celery::Except::OutOfRange();
+            }
+        }
+
+        [[nodiscard]] size_t id() const
+        {
+            return id_;
+        }
+
+        [[nodiscard]] const choice_set *set() const
+        {
+            return set_;
+        }
+
+        [[nodiscard]] const Celery::Str::External &str() const
+        {
+            return (*set_)[id_];
+        }
+
+        /**
+         * @brief Selects the option matching a string.
+         * @return Whether the string is one of the options.
+         */
+        bool select(const Celery::Str::External &option)
+        {
+            if (set_ == nullptr)
+            {
+                return false;
+            }
+
+            const size_t id = set_->find(option);
+            if (id == perfect_hash::NONE)
+            {
+                return false;
+            }
+
+            id_ = id;
+            return true;
+        }
+    };
+}
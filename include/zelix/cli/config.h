@@ -0,0 +1,257 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/5/25.
+//
+
+#pragma once
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+#include "celery/string/external.h"
+#include "error.h"
+
+namespace zelix::cli
+{
+    /**
+     * @brief A memory-mapped `key = value` configuration file.
+     *
+     * The file is mapped read-only and tokenized in place once, when
+     * it is opened: every section, key and value handed out is a slice
+     * into the mapping, so nothing is copied, parses only walk the
+     * index, and only the entries that are actually looked at are
+     * ever converted.
+     *
+     * Supported syntax:
+     * - `key = value` pairs, one per line
+     * - `[section]` headers
+     * - Comments starting with `#` or `;`
+     * - Values optionally wrapped in double quotes
+     *
+     * @note Slices are not null-terminated.
+     */
+    class config_file
+    {
+    public:
+        class entry
+        {
+        public:
+            Celery::Str::External section; ///< Empty for entries before the first section
+            Celery::Str::External key;
+            Celery::Str::External value;
+            size_t line = 0; ///< 1-based line number
+        };
+
+    private:
+        const char *data = nullptr;
+        size_t size = 0;
+        std::vector<entry> entries_; ///< Every `key = value` pair, in file order
+
+        static bool is_space(const char c)
+        {
+            return c == ' ' || c == '\t' || c == '\r';
+        }
+
+        static Celery::Str::External trim(const char *begin, const char *end)
+        {
+            while (begin < end && is_space(*begin))
+            {
+                ++begin;
+            }
+
+            while (end > begin && is_space(end[-1]))
+            {
+                --end;
+            }
+
+            return Celery::Str::External(begin, end - begin);
+        }
+
+        /**
+         * @brief Tokenizes the whole mapping into `entries_`.
+         * @return Whether the file is well-formed. On failure, the global
+         *         error is set to `MALFORMED_CONFIG`, with the offset of
+         *         the offending line.
+         */
+        bool index()
+        {
+            entry current;
+            size_t cursor = 0;
+            while (cursor < size)
+            {
+                const char *line = data + cursor;
+                const auto newline = static_cast<const char *>(
+                    memchr(line, '\n', size - cursor)
+                );
+
+                const char *line_end = newline == nullptr ? data + size : newline;
+                cursor = line_end - data + 1;
+                ++current.line;
+
+                const auto text = trim(line, line_end);
+                const char *ptr = text.Ptr();
+                if (text.Size() == 0 || ptr[0] == '#' || ptr[0] == ';')
+                {
+                    continue;
+                }
+
+                // Section headers
+                if (ptr[0] == '[')
+                {
+                    if (ptr[text.Size() - 1] != ']')
+                    {
+                        global_error.error_type = error::MALFORMED_CONFIG;
+                        global_error.argv_pos = 0;
+                        global_error.source = text;
+                        global_error.offset = ptr - data;
+                        return false;
+                    }
+
+                    current.section = trim(ptr + 1, ptr + text.Size() - 1);
+                    continue;
+                }
+
+                const auto equals = static_cast<const char *>(
+                    memchr(ptr, '=', text.Size())
+                );
+
+                if (equals == nullptr)
+                {
+                    continue; // Not a key = value pair
+                }
+
+                current.key = trim(ptr, equals);
+                current.value = trim(equals + 1, ptr + text.Size());
+
+                // Strip quotes
+                const auto value_ptr = current.value.Ptr();
+                if (
+                    current.value.Size() >= 2
+                    && value_ptr[0] == '"'
+                    && value_ptr[current.value.Size() - 1] == '"'
+                )
+                {
+                    current.value = Celery::Str::External(value_ptr + 1, current.value.Size() - 2);
+                }
+
+                entries_.push_back(current);
+            }
+
+            return true;
+        }
+
+    public:
+        explicit config_file() = default;
+
+        config_file(const config_file &) = delete;
+        config_file &operator=(const config_file &) = delete;
+
+        ~config_file()
+        {
+            close();
+        }
+
+        /**
+         * @brief Maps a configuration file into memory and indexes it.
+         * @param path The path to the file.
+         * @return Whether the file could be mapped and is well-formed. Missing
+         *         files are not an error for callers that treat the configuration
+         *         as optional; malformed ones also set the global error.
+         */
+        bool open(const char *path)
+        {
+            close();
+
+            const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+            {
+                return false;
+            }
+
+            struct stat st{};
+            if (fstat(fd, &st) != 0)
+            {
+                ::close(fd);
+                return false;
+            }
+
+            // Empty files can't be mapped, but they are valid
+            if (st.st_size == 0)
+            {
+                ::close(fd);
+                return true;
+            }
+
+            void *map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd); // The mapping keeps the file alive
+
+            if (map == MAP_FAILED)
+            {
+                return false;
+            }
+
+            data = static_cast<const char *>(map);
+            size = st.st_size;
+
+            // The mapping stays, the error points into it
+            if (!index())
+            {
+                entries_.clear();
+                return false;
+            }
+
+            return true;
+        }
+
+        void close()
+        {
+            if (data != nullptr)
+            {
+                munmap(const_cast<char *>(data), size);
+                data = nullptr;
+                size = 0;
+            }
+
+            entries_.clear();
+        }
+
+        [[nodiscard]] bool empty() const
+        {
+            return entries_.empty();
+        }
+
+        /**
+         * @brief Gets every `key = value` pair of the file, in file order.
+         */
+        [[nodiscard]] const std::vector<entry> &entries() const
+        {
+            return entries_;
+        }
+    };
+}
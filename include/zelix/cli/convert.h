@@ -0,0 +1,135 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/2/25.
+//
+
+#pragma once
+#include <charconv>
+#include <cstring>
+#include "celery/string/external.h"
+#include "choice.h"
+
+namespace zelix::cli
+{
+    /**
+     * @brief Converts a raw argument slice into a typed value.
+     *
+     * This is the single place where the parser turns text into
+     * numbers or booleans; both the eager map-filling path in
+     * `args` and the on-access conversions of positional views
+     * go through here.
+     *
+     * @param value The slice to convert.
+     * @param out Where to store the converted value. For choices, it
+     *            must already refer to the set of options.
+     * @return Whether the conversion succeeded.
+     */
+    template <typename T>
+    bool convert(const Celery::Str::External &value, T &out)
+    {
+        if constexpr (std::is_same_v<T, Celery::Str::External>)
+        {
+            out = value;
+            return true;
+        }
+        else if constexpr (std::is_same_v<T, const char *>)
+        {
+            // Callers make sure the slice is null-terminated, see `args::parse_config()`
+            out = value.Ptr();
+            return true;
+        }
+        else if constexpr (std::is_same_v<T, bool>)
+        {
+            if (value.Size() == 4 && memcmp(value.Ptr(), "true", 4) == 0)
+            {
+                out = true;
+                return true;
+            }
+
+            if (value.Size() == 5 && memcmp(value.Ptr(), "false", 5) == 0)
+            {
+                out = false;
+                return true;
+            }
+
+            return false; // Invalid boolean value
+        }
+        else if constexpr (std::is_same_v<T, int>)
+        {
+            int result = 0;
+            const auto value_ptr = value.Ptr();
+
+            if (value.Size() == 0)
+            {
+                return false;
+            }
+
+            // Iterate over the ptr
+            for (size_t i = 0; i < value.Size(); ++i)
+            {
+                const char c = value_ptr[i];
+                if (c < '0' || c > '9')
+                {
+                    return false; // Invalid integer value
+                }
+
+                result = result * 10 + (c - '0');
+            }
+
+            out = result;
+            return true;
+        }
+        else if constexpr (std::is_same_v<T, choice>)
+        {
+            return out.select(value);
+        }
+        else if constexpr (std::is_same_v<T, float>)
+        {
+            float result = 0.0f;
+            const auto value_ptr = value.Ptr();
+
+            if (
+                auto [ptr, ec] = std::from_chars(value_ptr, value_ptr + value.Size(), result);
+                ec != std::errc()
+            ) {
+                return false; // Invalid float value
+            }
+
+            out = result;
+            return true;
+        }
+        else
+        {
+            static_assert(
+                false,
+                "Unsupported type for value conversion"
+            );
+
+            return false; // Should never reach here
+        }
+    }
+}
@@ -0,0 +1,110 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/4/25.
+//
+
+#pragma once
+#include <cstring>
+#include "celery/string/external.h"
+#include "schema.h"
+
+extern "C"
+{
+    extern char **environ;
+}
+
+namespace zelix::cli
+{
+    /**
+     * @brief Lazily built, zero-copy index over the process environment.
+     *
+     * Instead of calling `getenv()` once per flag (which scans the whole
+     * environment every time), the environment is indexed once, the
+     * first time a value is actually needed. Keys and values are slices
+     * pointing into `environ`, nothing is copied.
+     *
+     * @note The index is a snapshot: changes made to the environment
+     *       after the first lookup are not seen.
+     */
+    class environment
+    {
+        static name_map<Celery::Str::External> build()
+        {
+            name_map<Celery::Str::External> index;
+            if (environ == nullptr)
+            {
+                return index;
+            }
+
+            for (char **entry = environ; *entry != nullptr; ++entry)
+            {
+                const char *ptr = *entry;
+                const char *equals = strchr(ptr, '=');
+                if (equals == nullptr)
+                {
+                    continue;
+                }
+
+                const auto key = Celery::Str::External(ptr, equals - ptr);
+
+                // Like getenv(), the first definition wins
+                if (!index.contains(key))
+                {
+                    index[key] = Celery::Str::External(equals + 1);
+                }
+            }
+
+            return index;
+        }
+
+    public:
+        [[nodiscard]] static const name_map<Celery::Str::External> &index()
+        {
+            static const name_map<Celery::Str::External> env_index = build();
+            return env_index;
+        }
+
+        /**
+         * @brief Looks up an environment variable.
+         * @param name The name of the variable.
+         * @param out Where to store the value, if found.
+         * @return Whether the variable is defined.
+         */
+        static bool lookup(const Celery::Str::External &name, Celery::Str::External &out)
+        {
+            const auto &env_index = index();
+            const auto it = env_index.find(name);
+            if (it == env_index.end())
+            {
+                return false;
+            }
+
+            out = it->second;
+            return true;
+        }
+    };
+}
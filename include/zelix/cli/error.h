@@ -0,0 +1,73 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/2/25.
+//
+
+#pragma once
+#include <cstddef>
+#include "celery/string/external.h"
+
+namespace zelix::cli
+{
+    class error
+    {
+    public:
+        enum type
+        {
+            UNKNOWN,
+            EXPECTED_VALUE,
+            NOT_EXPECTED_VALUE,
+            UNKNOWN_COMMAND,
+            UNKNOWN_FLAG,
+            TYPE_MISMATCH,
+            INVALID_ENV,
+            INVALID_CONFIG,
+            UNTERMINATED_QUOTE,
+            TOO_MANY_ARGUMENTS,
+            INVALID_CHOICE,
+            MISSING_REQUIRED,
+            CONFLICTING_ARGUMENTS,
+            MISSING_DEPENDENCY,
+            INVALID_UTF8,
+            CONTROL_CHARACTER,
+            LIMIT_EXCEEDED,
+            PATH_NOT_FOUND,
+            NOT_A_FILE,
+            NOT_A_DIRECTORY,
+            SPLIT_VARIADIC,
+            MALFORMED_CONFIG,
+            UNTERMINATED_ESCAPE,
+        };
+
+        type error_type = UNKNOWN; ///< Type of the error
+        size_t argv_pos = 0; ///< Position in the argv array where the error occurred
+        Celery::Str::External source; ///< Offending variable or key, for errors outside argv
+        size_t offset = 0; ///< Offending byte within the value, for text errors
+    };
+
+    inline thread_local error global_error; ///< Last error of the calling thread
+}
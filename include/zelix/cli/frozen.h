@@ -0,0 +1,815 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/23/25.
+//
+
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <memory>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+#include "ankerl/unordered_dense.h"
+#include "celery/except/base.h"
+#include "celery/string/external.h"
+#include "choice.h"
+#include "perfect_hash.h"
+#include "schema.h"
+#include "serialize.h"
+#include "value.h"
+
+namespace zelix::cli
+{
+    /**
+     * @brief Layout of the buffers produced by `app::freeze()`.
+     *
+     * Like `blob`, everything is addressed by offsets, so a frozen
+     * schema can be written to a file or a shared memory segment once
+     * and mapped by every process that needs it:
+     *
+     * ```
+     * header
+     * entry            entries[slot_count]          ///< Commands and flags, by slot
+     * positional       positionals[positional_count]
+     * table            tables[TABLE_COUNT]          ///< Name lookups, see `frozen_index`
+     * blob::list       lists[list_count]            ///< Exclusive groups, dependencies, then choice sets
+     * uint32_t         indices[index_count]         ///< Slots or string indices by list, then table buckets
+     * blob::string_ref strings[string_count]
+     * char             pool[pool_size]              ///< Null-terminated strings
+     * ```
+     */
+    namespace frozen
+    {
+        inline constexpr uint32_t MAGIC = 0x464c435a; ///< "ZCLF"
+        inline constexpr uint16_t VERSION = 2;
+        inline constexpr uint32_t NONE = UINT32_MAX;
+
+        enum table_id : uint8_t
+        {
+            COMMANDS,
+            COMMAND_ALIASES,
+            FLAGS,
+            FLAG_ALIASES,
+            POSITIONALS,
+            TABLE_COUNT
+        };
+
+        class header
+        {
+        public:
+            uint32_t magic = MAGIC;
+            uint16_t version = VERSION;
+            uint8_t check_utf8 = 0;
+            uint8_t reject_control = 0;
+            uint64_t fingerprint = 0; ///< Fingerprint of the schema
+            uint32_t name = 0; ///< String index of the app name
+            uint32_t description = 0;
+            uint32_t listing = 0; ///< String index of the prebuilt help listing
+            uint32_t listing_ascii = 0; ///< Same, without Unicode symbols
+            uint32_t slot_count = 0;
+            uint32_t positional_count = 0;
+            uint32_t group_count = 0;
+            uint32_t dependency_count = 0;
+            uint32_t list_count = 0;
+            uint32_t index_count = 0;
+            uint32_t string_count = 0;
+            uint32_t pool_size = 0;
+        };
+
+        class entry
+        {
+        public:
+            uint32_t name = 0; ///< String indices
+            uint32_t alias = 0;
+            uint32_t description = 0;
+            uint32_t env = NONE; ///< Environment variable of a flag, if any
+            uint32_t slot = 0;
+            uint32_t owner = NONE; ///< Command that registered the entry, `NONE` for globals
+            uint8_t type = value::STRING; ///< A `value::type`
+            uint8_t command = 0; ///< Whether the entry is a command
+            uint8_t required = 0;
+            uint8_t reserved = 0;
+            uint32_t choices = NONE; ///< List of options, for choices
+            uint64_t payload = 0; ///< The default value, or a string index for strings
+        };
+
+        class positional
+        {
+        public:
+            uint32_t name = 0;
+            uint32_t description = 0;
+            uint32_t variadic = 0;
+            uint32_t reserved = 0;
+        };
+
+        /**
+         * @brief A `perfect_hash` over slot indices (positional indices for positionals).
+         */
+        class table
+        {
+        public:
+            uint64_t seed = 0;
+            uint32_t first = 0; ///< Index of the first bucket in `indices`
+            uint32_t size = 0; ///< Number of buckets, a power of two
+            uint32_t probing = 0;
+            uint32_t reserved = 0;
+        };
+
+        /**
+         * @brief Builds a frozen schema.
+         */
+        class writer
+        {
+            const schema &schema_;
+
+            header head;
+            std::vector<entry> entries;
+            std::vector<positional> positionals;
+            table tables[TABLE_COUNT];
+            std::vector<blob::list> lists;
+            std::vector<uint32_t> indices;
+            std::vector<blob::string_ref> strings;
+            std::vector<char> pool;
+
+            template <typename T>
+            static void append(std::vector<unsigned char> &out, const T *data, const size_t count)
+            {
+                const auto bytes = reinterpret_cast<const unsigned char *>(data);
+                out.insert(out.end(), bytes, bytes + sizeof(T) * count);
+            }
+
+            uint32_t string(const Celery::Str::External &str)
+            {
+                strings.push_back(blob::string_ref{static_cast<uint32_t>(pool.size()), static_cast<uint32_t>(str.Size())});
+                pool.insert(pool.end(), str.Ptr(), str.Ptr() + str.Size());
+                pool.push_back('\0');
+                return static_cast<uint32_t>(strings.size() - 1);
+            }
+
+            uint32_t string(const char *str)
+            {
+                return string(Celery::Str::External(str, strlen(str)));
+            }
+
+            void add_list(const slot_set &set, const size_t first = SIZE_MAX)
+            {
+                blob::list l;
+                l.first = static_cast<uint32_t>(indices.size());
+
+                if (first != SIZE_MAX)
+                {
+                    indices.push_back(static_cast<uint32_t>(first));
+                }
+
+                for (size_t slot = 0; slot < schema_.slots; ++slot)
+                {
+                    if (set.test(slot))
+                    {
+                        indices.push_back(static_cast<uint32_t>(slot));
+                    }
+                }
+
+                l.count = static_cast<uint32_t>(indices.size() - l.first);
+                lists.push_back(l);
+            }
+
+            void add_table(const table_id id, const perfect_hash &lookup)
+            {
+                auto &t = tables[id];
+                t.seed = lookup.get_seed();
+                t.first = static_cast<uint32_t>(indices.size());
+                t.size = static_cast<uint32_t>(lookup.size());
+                t.probing = lookup.is_probing();
+                indices.insert(indices.end(), lookup.buckets(), lookup.buckets() + lookup.size());
+            }
+
+            void add_entry(
+                const size_t slot,
+                ankerl::unordered_dense::map<const choice_set *, uint32_t> &choice_lists
+            )
+            {
+                const auto &val = schema_.values[slot];
+                const bool command = schema_.command_slots.test(slot);
+
+                if (schema_.is_computed(val))
+                {
+                    throw Celery::Except::Exception("Computed defaults cannot be frozen");
+                }
+
+                entry e;
+                e.name = string(schema_.slot_names[slot]);
+                e.alias = string(schema_.slot_aliases[slot]);
+                e.description = string(val.get_description());
+                e.slot = static_cast<uint32_t>(slot);
+                e.type = static_cast<uint8_t>(val.get_type());
+                e.command = command;
+                e.required = schema_.required.test(val.get_slot());
+
+                if (const size_t owner = schema_.owners[slot]; owner != SIZE_MAX)
+                {
+                    e.owner = static_cast<uint32_t>(owner);
+                }
+
+                if (const auto &env = schema_.slot_envs[slot]; env.Size() != 0)
+                {
+                    e.env = string(env);
+                }
+
+                switch (val.get_type())
+                {
+                    case value::STRING:
+                        e.payload = string(val.get<Celery::Str::External>());
+                        break;
+
+                    case value::INTEGER:
+                    {
+                        const int def = val.get<int>();
+                        memcpy(&e.payload, &def, sizeof(def));
+                        break;
+                    }
+
+                    case value::FLOAT:
+                    {
+                        const float def = val.get<float>();
+                        memcpy(&e.payload, &def, sizeof(def));
+                        break;
+                    }
+
+                    case value::BOOL:
+                        e.payload = val.get<bool>();
+                        break;
+
+                    case value::CHOICE:
+                    {
+                        const auto def = val.get<choice>();
+                        e.payload = def.id();
+
+                        // Choice sets are usually shared between flags, store each once
+                        const auto [it, inserted] = choice_lists.try_emplace(
+                            def.set(),
+                            static_cast<uint32_t>(lists.size())
+                        );
+
+                        if (inserted)
+                        {
+                            blob::list l;
+                            l.first = static_cast<uint32_t>(indices.size());
+                            l.count = static_cast<uint32_t>(def.set()->size());
+
+                            for (size_t i = 0; i < def.set()->size(); ++i)
+                            {
+                                indices.push_back(string((*def.set())[i]));
+                            }
+
+                            lists.push_back(l);
+                        }
+
+                        e.choices = it->second;
+                        break;
+                    }
+
+                    default:
+                        throw Celery::Except::Exception("Custom value types cannot be frozen");
+                }
+
+                entries[slot] = e;
+            }
+
+        public:
+            explicit writer(const schema &schema_) :
+                schema_(schema_), entries(schema_.slots)
+            {
+                if (!schema_.registrars.empty())
+                {
+                    throw Celery::Except::Exception("Commands with on-demand flags cannot be frozen");
+                }
+
+                if (!schema_.slot_paths.empty() || !schema_.positional_paths.empty())
+                {
+                    throw Celery::Except::Exception("Path checks cannot be frozen, add them after loading the image");
+                }
+
+                for (const auto &dest : schema_.bindings)
+                {
+                    if (dest.write != nullptr)
+                    {
+                        throw Celery::Except::Exception("Bound flags cannot be frozen");
+                    }
+                }
+            }
+
+            /**
+             * @brief Serializes the schema.
+             * @param name The name of the app.
+             * @param description The description of the app.
+             * @param listing The help listing of commands, positionals and flags.
+             * @param listing_ascii The same listing, without Unicode symbols.
+             */
+            [[nodiscard]] std::vector<unsigned char> finish(
+                const char *name,
+                const char *description,
+                const char *listing,
+                const char *listing_ascii
+            )
+            {
+                head.fingerprint = schema_.fingerprint();
+                head.check_utf8 = schema_.check_utf8;
+                head.reject_control = schema_.reject_control;
+                head.name = string(name);
+                head.description = string(description);
+                head.listing = string(listing);
+                head.listing_ascii = string(listing_ascii);
+
+                // Lists are read back in order: groups, dependencies, then choices
+                for (const auto &group : schema_.exclusive_groups)
+                {
+                    add_list(group);
+                }
+
+                for (const auto &dep : schema_.dependencies)
+                {
+                    add_list(dep.needs, dep.slot);
+                }
+
+                ankerl::unordered_dense::map<const choice_set *, uint32_t> choice_lists;
+                std::vector<uint32_t> command_slots;
+                std::vector<uint32_t> flag_slots;
+                for (size_t slot = 0; slot < schema_.slots; ++slot)
+                {
+                    add_entry(slot, choice_lists);
+                    (schema_.command_slots.test(slot) ? command_slots : flag_slots).push_back(
+                        static_cast<uint32_t>(slot)
+                    );
+                }
+
+                std::vector<Celery::Str::External> positional_names;
+                for (const auto &pos : schema_.positionals)
+                {
+                    positional p;
+                    p.name = string(pos.name);
+                    p.description = string(pos.description);
+                    p.variadic = pos.variadic;
+                    positionals.push_back(p);
+                    positional_names.push_back(pos.name);
+                }
+
+                // Searching for seeds is the slow part, so it is done once, here
+                const auto &names = schema_.slot_names;
+                const auto &aliases = schema_.slot_aliases;
+                add_table(COMMANDS, perfect_hash(names.data(), command_slots.data(), command_slots.size()));
+                add_table(COMMAND_ALIASES, perfect_hash(aliases.data(), command_slots.data(), command_slots.size()));
+                add_table(FLAGS, perfect_hash(names.data(), flag_slots.data(), flag_slots.size()));
+                add_table(FLAG_ALIASES, perfect_hash(aliases.data(), flag_slots.data(), flag_slots.size()));
+                add_table(POSITIONALS, perfect_hash(positional_names.data(), positional_names.size()));
+
+                // Keep the string references that follow 8-byte aligned
+                if (indices.size() % 2 != 0)
+                {
+                    indices.push_back(NONE);
+                }
+
+                head.slot_count = static_cast<uint32_t>(entries.size());
+                head.positional_count = static_cast<uint32_t>(positionals.size());
+                head.group_count = static_cast<uint32_t>(schema_.exclusive_groups.size());
+                head.dependency_count = static_cast<uint32_t>(schema_.dependencies.size());
+                head.list_count = static_cast<uint32_t>(lists.size());
+                head.index_count = static_cast<uint32_t>(indices.size());
+                head.string_count = static_cast<uint32_t>(strings.size());
+                head.pool_size = static_cast<uint32_t>(pool.size());
+
+                std::vector<unsigned char> out;
+                out.reserve(
+                    sizeof(header)
+                    + entries.size() * sizeof(entry)
+                    + positionals.size() * sizeof(positional)
+                    + sizeof(tables)
+                    + lists.size() * sizeof(blob::list)
+                    + indices.size() * sizeof(uint32_t)
+                    + strings.size() * sizeof(blob::string_ref)
+                    + pool.size()
+                );
+
+                append(out, &head, 1);
+                append(out, entries.data(), entries.size());
+                append(out, positionals.data(), positionals.size());
+                append(out, tables, TABLE_COUNT);
+                append(out, lists.data(), lists.size());
+                append(out, indices.data(), indices.size());
+                append(out, strings.data(), strings.size());
+                append(out, pool.data(), pool.size());
+                return out;
+            }
+        };
+    }
+
+    /**
+     * @brief Read-only view over a schema frozen with `app::freeze()`.
+     *
+     * The image is either mapped from a file or attached to memory the
+     * caller already holds, e.g. a shared memory segment. Every name,
+     * description and string default handed to an app built from it is
+     * a slice into the image, which must outlive that app.
+     */
+    class schema_image
+    {
+        const unsigned char *data = nullptr;
+        size_t size = 0;
+        bool mapped = false; ///< Whether the image owns a mapping
+
+        frozen::header head;
+        const frozen::entry *entries = nullptr;
+        const frozen::positional *positionals = nullptr;
+        const frozen::table *tables = nullptr;
+        const blob::list *lists = nullptr;
+        const uint32_t *indices = nullptr;
+        const blob::string_ref *strings = nullptr;
+        const char *pool = nullptr;
+
+        std::vector<std::unique_ptr<choice_set>> choice_sets; ///< Choice set of each list, if any
+
+        // Keys of the lookup tables, which compare against slices of the image
+        std::vector<Celery::Str::External> names; ///< By slot
+        std::vector<Celery::Str::External> aliases; ///< By slot
+        std::vector<Celery::Str::External> positional_names;
+        frozen_index index;
+
+        [[nodiscard]] Celery::Str::External string(const uint32_t i) const
+        {
+            return Celery::Str::External(pool + strings[i].offset, strings[i].size);
+        }
+
+        void load(const void *bytes, const size_t length)
+        {
+            data = static_cast<const unsigned char *>(bytes);
+            size = length;
+
+            if (size < sizeof(frozen::header))
+            {
+                throw Celery::Except::Exception("Buffer is too small");
+            }
+
+            memcpy(&head, data, sizeof(frozen::header));
+            if (head.magic != frozen::MAGIC || head.version != frozen::VERSION)
+            {
+                throw Celery::Except::Exception("Not a frozen schema");
+            }
+
+            const size_t expected = sizeof(frozen::header)
+                + static_cast<size_t>(head.slot_count) * sizeof(frozen::entry)
+                + static_cast<size_t>(head.positional_count) * sizeof(frozen::positional)
+                + frozen::TABLE_COUNT * sizeof(frozen::table)
+                + static_cast<size_t>(head.list_count) * sizeof(blob::list)
+                + static_cast<size_t>(head.index_count) * sizeof(uint32_t)
+                + static_cast<size_t>(head.string_count) * sizeof(blob::string_ref)
+                + head.pool_size;
+
+            if (size < expected)
+            {
+                throw Celery::Except::Exception("Buffer is truncated");
+            }
+
+            const unsigned char *cursor = data + sizeof(frozen::header);
+            entries = reinterpret_cast<const frozen::entry *>(cursor);
+            cursor += head.slot_count * sizeof(frozen::entry);
+            positionals = reinterpret_cast<const frozen::positional *>(cursor);
+            cursor += head.positional_count * sizeof(frozen::positional);
+            tables = reinterpret_cast<const frozen::table *>(cursor);
+            cursor += frozen::TABLE_COUNT * sizeof(frozen::table);
+            lists = reinterpret_cast<const blob::list *>(cursor);
+            cursor += head.list_count * sizeof(blob::list);
+            indices = reinterpret_cast<const uint32_t *>(cursor);
+            cursor += head.index_count * sizeof(uint32_t);
+            strings = reinterpret_cast<const blob::string_ref *>(cursor);
+            cursor += head.string_count * sizeof(blob::string_ref);
+            pool = reinterpret_cast<const char *>(cursor);
+
+            names.resize(head.slot_count);
+            aliases.resize(head.slot_count);
+            for (size_t i = 0; i < head.slot_count; ++i)
+            {
+                if (entries[i].slot != i)
+                {
+                    throw Celery::Except::Exception("Not a frozen schema");
+                }
+
+                names[i] = string(entries[i].name);
+                aliases[i] = string(entries[i].alias);
+            }
+
+            positional_names.resize(head.positional_count);
+            for (size_t i = 0; i < head.positional_count; ++i)
+            {
+                positional_names[i] = string(positionals[i].name);
+            }
+
+            index.commands = lookup(frozen::COMMANDS, names.data());
+            index.command_aliases = lookup(frozen::COMMAND_ALIASES, aliases.data());
+            index.flags = lookup(frozen::FLAGS, names.data());
+            index.flag_aliases = lookup(frozen::FLAG_ALIASES, aliases.data());
+            index.positionals = lookup(frozen::POSITIONALS, positional_names.data());
+
+            // Choice defaults point to a set, so those are rebuilt once per process
+            choice_sets.clear();
+            choice_sets.resize(head.list_count);
+            for (size_t i = 0; i < head.slot_count; ++i)
+            {
+                const auto &e = entries[i];
+                if (e.choices == frozen::NONE || choice_sets[e.choices] != nullptr)
+                {
+                    continue;
+                }
+
+                const auto &l = lists[e.choices];
+                std::vector<Celery::Str::External> options;
+                options.reserve(l.count);
+
+                for (size_t j = 0; j < l.count; ++j)
+                {
+                    options.push_back(string(indices[l.first + j]));
+                }
+
+                choice_sets[e.choices] = std::make_unique<choice_set>(std::move(options));
+            }
+        }
+
+        /**
+         * @brief Uses a lookup table of the image in place, without rebuilding it.
+         */
+        [[nodiscard]] perfect_hash lookup(const frozen::table_id id, const Celery::Str::External *keys) const
+        {
+            const auto &t = tables[id];
+            if (
+                t.size == 0
+                || (t.size & (t.size - 1)) != 0
+                || static_cast<size_t>(t.first) + t.size > head.index_count
+            )
+            {
+                throw Celery::Except::Exception("Not a frozen schema");
+            }
+
+            return perfect_hash(keys, t.seed, t.probing != 0, indices + t.first, t.size);
+        }
+
+        [[nodiscard]] value make_value(const frozen::entry &e) const
+        {
+            const auto description = string(e.description);
+            switch (e.type)
+            {
+                case value::STRING:
+                    return value(string(static_cast<uint32_t>(e.payload)), description);
+
+                case value::INTEGER:
+                {
+                    int def;
+                    memcpy(&def, &e.payload, sizeof(def));
+                    return value(def, description);
+                }
+
+                case value::FLOAT:
+                {
+                    float def;
+                    memcpy(&def, &e.payload, sizeof(def));
+                    return value(def, description);
+                }
+
+                case value::BOOL:
+                    return value(e.payload != 0, description);
+
+                case value::CHOICE:
+                    return value(choice(*choice_sets[e.choices], e.payload), description);
+
+                default:
+                    throw Celery::Except::Exception("Not a frozen schema");
+            }
+        }
+
+    public:
+        explicit schema_image() = default;
+
+        schema_image(const schema_image &) = delete;
+        schema_image &operator=(const schema_image &) = delete;
+
+        ~schema_image()
+        {
+            close();
+        }
+
+        /**
+         * @brief Maps a frozen schema file into memory.
+         *
+         * The mapping is shared and read-only, so every process that
+         * maps the same file shares its pages.
+         *
+         * @param path The path to the file.
+         * @return Whether the file could be mapped. Throws if it is not a frozen schema.
+         */
+        bool open(const char *path)
+        {
+            close();
+
+            const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+            {
+                return false;
+            }
+
+            struct stat st{};
+            if (fstat(fd, &st) != 0 || st.st_size == 0)
+            {
+                ::close(fd);
+                return false;
+            }
+
+            void *map = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+            ::close(fd); // The mapping keeps the file alive
+
+            if (map == MAP_FAILED)
+            {
+                return false;
+            }
+
+            mapped = true;
+            try
+            {
+                load(map, st.st_size);
+            }
+            catch (...)
+            {
+                close();
+                throw;
+            }
+
+            return true;
+        }
+
+        /**
+         * @brief Uses a frozen schema the caller already holds in memory.
+         *
+         * Throws if the buffer is not a frozen schema.
+         *
+         * @param bytes The buffer, which must outlive the image and be 8-byte aligned.
+         * @param length The size of the buffer.
+         */
+        void attach(const void *bytes, const size_t length)
+        {
+            close();
+            load(bytes, length);
+        }
+
+        void close()
+        {
+            if (mapped)
+            {
+                munmap(const_cast<unsigned char *>(data), size);
+                mapped = false;
+            }
+
+            data = nullptr;
+            size = 0;
+            choice_sets.clear();
+            names.clear();
+            aliases.clear();
+            positional_names.clear();
+            index = frozen_index();
+        }
+
+        [[nodiscard]] bool is_open() const
+        {
+            return data != nullptr;
+        }
+
+        [[nodiscard]] const char *name() const
+        {
+            return string(head.name).Ptr();
+        }
+
+        [[nodiscard]] const char *description() const
+        {
+            return string(head.description).Ptr();
+        }
+
+        /**
+         * @brief Gets the prebuilt help listing of commands, positionals and flags.
+         */
+        template <bool Unicode = true>
+        [[nodiscard]] Celery::Str::External listing() const
+        {
+            return string(Unicode ? head.listing : head.listing_ascii);
+        }
+
+        /**
+         * @brief Fills a schema from the image.
+         *
+         * Names are looked up through the tables stored in the image,
+         * so nothing is hashed here; only the per-slot values are copied.
+         *
+         * @param out An empty schema.
+         */
+        void thaw(schema &out) const
+        {
+            if (data == nullptr)
+            {
+                throw Celery::Except::Exception("No frozen schema is loaded");
+            }
+
+            out.slots = head.slot_count;
+            out.values.reserve(head.slot_count);
+            out.slot_names = names;
+            out.slot_aliases = aliases;
+            out.slot_envs.resize(head.slot_count);
+            out.owners.resize(head.slot_count);
+
+            for (size_t i = 0; i < head.slot_count; ++i)
+            {
+                const auto &e = entries[i];
+
+                value val = make_value(e);
+                val.set_slot(i);
+                out.values.push_back(std::move(val));
+
+                if (e.command)
+                {
+                    out.command_slots.set(i);
+                }
+                else if (e.env != frozen::NONE)
+                {
+                    out.slot_envs[i] = string(e.env);
+                    out.env_slots.push_back(i);
+                }
+
+                if (e.required)
+                {
+                    out.required.set(i);
+                }
+
+                out.owners[i] = e.owner == frozen::NONE ? SIZE_MAX : e.owner;
+            }
+
+            for (size_t i = 0; i < head.positional_count; ++i)
+            {
+                const auto &pos = positionals[i];
+                out.positionals.push_back(positional_spec{positional_names[i], string(pos.description), pos.variadic != 0});
+            }
+
+            for (size_t i = 0; i < head.group_count + head.dependency_count; ++i)
+            {
+                const auto &l = lists[i];
+                const bool dependent = i >= head.group_count;
+
+                slot_set set;
+                for (size_t j = dependent; j < l.count; ++j)
+                {
+                    set.set(indices[l.first + j]);
+                }
+
+                if (dependent)
+                {
+                    dependency dep;
+                    dep.slot = indices[l.first];
+                    dep.needs = set;
+                    out.dependencies.push_back(dep);
+                }
+                else
+                {
+                    out.exclusive_groups.push_back(set);
+                }
+            }
+
+            out.check_utf8 = head.check_utf8;
+            out.reject_control = head.reject_control;
+            out.frozen = &index;
+
+            if (out.fingerprint() != head.fingerprint)
+            {
+                throw Celery::Except::Exception("Schema fingerprint mismatch");
+            }
+        }
+    };
+}
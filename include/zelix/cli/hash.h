@@ -0,0 +1,193 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/12/25.
+//
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include "celery/string/external.h"
+
+namespace zelix::cli
+{
+    /**
+     * @brief 64-bit FNV-1a, used where hashes must be stable across
+     *        processes and builds (fingerprints, cache keys).
+     */
+    class fnv1a
+    {
+        uint64_t state = 0xcbf29ce484222325ULL;
+
+    public:
+        explicit fnv1a() = default;
+
+        /**
+         * @brief Starts a hash from a seed, for hash families.
+         */
+        explicit fnv1a(const uint64_t seed) :
+            state(0xcbf29ce484222325ULL ^ (seed * 0x9e3779b97f4a7c15ULL))
+        {}
+
+        fnv1a &update(const void *data, const size_t size)
+        {
+            const auto bytes = static_cast<const unsigned char *>(data);
+            for (size_t i = 0; i < size; ++i)
+            {
+                state ^= bytes[i];
+                state *= 0x100000001b3ULL;
+            }
+
+            return *this;
+        }
+
+        template <typename T>
+        fnv1a &update(const T &value)
+        {
+            return update(&value, sizeof(T));
+        }
+
+        [[nodiscard]] uint64_t digest() const
+        {
+            return state;
+        }
+    };
+
+    /**
+     * @brief SipHash-1-3, a keyed hash whose collisions can't be
+     *        found without knowing the key.
+     */
+    class siphash
+    {
+        uint64_t v0;
+        uint64_t v1;
+        uint64_t v2;
+        uint64_t v3;
+
+        static uint64_t rotl(const uint64_t x, const int bits)
+        {
+            return (x << bits) | (x >> (64 - bits));
+        }
+
+        void round()
+        {
+            v0 += v1;
+            v1 = rotl(v1, 13);
+            v1 ^= v0;
+            v0 = rotl(v0, 32);
+            v2 += v3;
+            v3 = rotl(v3, 16);
+            v3 ^= v2;
+            v0 += v3;
+            v3 = rotl(v3, 21);
+            v3 ^= v0;
+            v2 += v1;
+            v1 = rotl(v1, 17);
+            v1 ^= v2;
+            v2 = rotl(v2, 32);
+        }
+
+        void compress(const uint64_t block)
+        {
+            v3 ^= block;
+            round();
+            v0 ^= block;
+        }
+
+    public:
+        explicit siphash(const uint64_t k0, const uint64_t k1) :
+            v0(k0 ^ 0x736f6d6570736575ULL),
+            v1(k1 ^ 0x646f72616e646f6dULL),
+            v2(k0 ^ 0x6c7967656e657261ULL),
+            v3(k1 ^ 0x7465646279746573ULL)
+        {}
+
+        /**
+         * @brief Hashes a whole message; the state can't be reused.
+         */
+        [[nodiscard]] uint64_t digest(const void *data, const size_t size)
+        {
+            const auto bytes = static_cast<const unsigned char *>(data);
+            const size_t tail = size & 7;
+
+            for (size_t i = 0; i < size - tail; i += 8)
+            {
+                uint64_t block;
+                memcpy(&block, bytes + i, sizeof(block));
+                compress(block);
+            }
+
+            uint64_t last = static_cast<uint64_t>(size) << 56;
+            for (size_t i = 0; i < tail; ++i)
+            {
+                last |= static_cast<uint64_t>(bytes[size - tail + i]) << (i * 8);
+            }
+
+            compress(last);
+
+            v2 ^= 0xff;
+            round();
+            round();
+            round();
+            return v0 ^ v1 ^ v2 ^ v3;
+        }
+    };
+
+    /**
+     * @brief Hasher for name tables under `ZELIX_CLI_SEEDED_HASH`.
+     *
+     * Keys are drawn once per process, so hashes differ between runs
+     * and inputs that collide in one process can't be precomputed.
+     */
+    class seeded_hash
+    {
+        class key
+        {
+        public:
+            uint64_t k0 = 0;
+            uint64_t k1 = 0;
+
+            explicit key()
+            {
+                std::random_device random;
+                k0 = (static_cast<uint64_t>(random()) << 32) | random();
+                k1 = (static_cast<uint64_t>(random()) << 32) | random();
+            }
+        };
+
+    public:
+        using is_avalanching = void; ///< Output is already well mixed, see `ankerl::unordered_dense`
+
+        size_t operator()(const Celery::Str::External &str) const
+        {
+            // Drawn on first use, so tables built during static initialization work too
+            static const key process_key;
+            return siphash(process_key.k0, process_key.k1).digest(str.Ptr(), str.Size());
+        }
+    };
+}
@@ -0,0 +1,119 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/19/25.
+//
+
+#pragma once
+#include "app.h"
+
+/*
+ * Instantiations shared by every program linking `ZelixCLI::compiled`.
+ *
+ * They are declared `extern` here, so programs reuse the copies in
+ * the library instead of compiling their own. `src/compiled.cpp`
+ * defines ZELIX_CLI_INSTANTIATE before including this header, which
+ * turns the declarations into the definitions.
+ */
+#ifdef ZELIX_CLI_INSTANTIATE
+#define ZELIX_CLI_EXTERN
+#else
+#define ZELIX_CLI_EXTERN extern
+#endif
+
+#define ZELIX_CLI_INSTANTIATE_TYPE(T)                                                           \
+    ZELIX_CLI_EXTERN template value::value(T, const Celery::Str::External &);                   \
+    ZELIX_CLI_EXTERN template T value::get<T>() const;                                          \
+    ZELIX_CLI_EXTERN template const value_ops *ops_of<T>();                                     \
+    ZELIX_CLI_EXTERN template size_t app::command<T>(                                           \
+        const Celery::Str::External &,                                                          \
+        const Celery::Str::External &,                                                          \
+        const Celery::Str::External &,                                                          \
+        const T &                                                                               \
+    );                                                                                          \
+    ZELIX_CLI_EXTERN template size_t app::command<T>(                                           \
+        const char *, const char *, const char *, const T &                                     \
+    );                                                                                          \
+    ZELIX_CLI_EXTERN template size_t app::flag<T>(                                              \
+        const Celery::Str::External &,                                                          \
+        const Celery::Str::External &,                                                          \
+        const Celery::Str::External &,                                                          \
+        const T &                                                                               \
+    );                                                                                          \
+    ZELIX_CLI_EXTERN template size_t app::flag<T>(                                              \
+        const char *, const char *, const char *, const T &                                     \
+    );                                                                                          \
+    ZELIX_CLI_EXTERN template bool args::parse_value<T, bool>(                                  \
+        const Celery::Str::External &, Celery::Str::External &                                  \
+    );                                                                                          \
+    ZELIX_CLI_EXTERN template bool args::parse_value<T, int>(                                   \
+        const Celery::Str::External &, Celery::Str::External &                                  \
+    );                                                                                          \
+    ZELIX_CLI_EXTERN template T args::val<T, bool>(const Celery::Str::External &);              \
+    ZELIX_CLI_EXTERN template T args::val<T, int>(const Celery::Str::External &);               \
+    ZELIX_CLI_EXTERN template T args::flag<T>(const Celery::Str::External &);                   \
+    ZELIX_CLI_EXTERN template T args::flag<T>(const char *);                                    \
+    ZELIX_CLI_EXTERN template T args::command<T>(const Celery::Str::External &);                \
+    ZELIX_CLI_EXTERN template T args::command<T>(const char *);
+
+namespace zelix::cli
+{
+    ZELIX_CLI_INSTANTIATE_TYPE(Celery::Str::External)
+    ZELIX_CLI_INSTANTIATE_TYPE(int)
+    ZELIX_CLI_INSTANTIATE_TYPE(float)
+    ZELIX_CLI_INSTANTIATE_TYPE(bool)
+    ZELIX_CLI_INSTANTIATE_TYPE(choice)
+
+    // String defaults are usually given as literals
+    ZELIX_CLI_EXTERN template value::value(const char *, const Celery::Str::External &);
+    ZELIX_CLI_EXTERN template const value_ops *ops_of<const char *>();
+
+    ZELIX_CLI_EXTERN template bool args::store<bool>(
+        const value &,
+        const Celery::Str::External &,
+        Celery::Str::External &,
+        size_t,
+        error::type,
+        const Celery::Str::External &
+    );
+
+    ZELIX_CLI_EXTERN template bool args::store<int>(
+        const value &,
+        const Celery::Str::External &,
+        Celery::Str::External &,
+        size_t,
+        error::type,
+        const Celery::Str::External &
+    );
+
+    ZELIX_CLI_EXTERN template args app::parse<false>();
+    ZELIX_CLI_EXTERN template args app::parse<true>();
+    ZELIX_CLI_EXTERN template args app::parse<false>(int, const char **, const size_t *);
+    ZELIX_CLI_EXTERN template args app::parse<true>(int, const char **, const size_t *);
+}
+
+#undef ZELIX_CLI_INSTANTIATE_TYPE
+#undef ZELIX_CLI_EXTERN
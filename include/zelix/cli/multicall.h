@@ -0,0 +1,262 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/20/25.
+//
+
+#pragma once
+#include <cstring>
+#include <functional>
+#include <optional>
+#include <vector>
+#include "celery/misc/ansi.h"
+#include "celery/string/external.h"
+#include "celery/string/string.h"
+#include "app.h"
+#include "error.h"
+#include "perfect_hash.h"
+
+namespace zelix::cli
+{
+    /**
+     * @brief Serves many tools from one binary, busybox-style.
+     *
+     * Each tool is a regular `app`, selected by the name the binary
+     * was invoked as (e.g. through a symlink), or by the first
+     * argument when invoked under its own name (`prog tool ...`).
+     * Selecting a tool costs a basename scan and a single perfect
+     * hash lookup.
+     *
+     * Tools are registered as a name and a function filling in their
+     * app, like per-command flags (see `app::command()`). Only the
+     * selected tool's app is ever built, so a binary serving many
+     * tools parses about as fast as one serving a single app.
+     */
+    class multicall
+    {
+        /**
+         * @brief A tool whose app is only built when it is selected.
+         */
+        class tool_spec
+        {
+        public:
+            const char *description = nullptr;
+            std::function<void(app &)> registrar; ///< Registers the commands and flags of the tool
+        };
+
+        const char *name_;
+        int argc;
+        const char **argv;
+
+        std::vector<tool_spec> tools;
+        std::vector<Celery::Str::External> names; ///< Tool names, by index into `tools`
+        perfect_hash index;
+        bool stale = true; ///< Whether tools were added since `index` was built
+
+        std::optional<app> selected; ///< App of the dispatched tool
+
+        [[nodiscard]] size_t find(const Celery::Str::External &tool)
+        {
+            if (stale)
+            {
+                index = perfect_hash(names.data(), names.size());
+                stale = false;
+            }
+
+            return index.find(tool);
+        }
+
+    public:
+        /**
+         * @param name The name of the binary itself, used in `prog tool ...` invocations.
+         * @param argc The number of arguments.
+         * @param argv The arguments, as given to `main()`.
+         */
+        explicit multicall(const char *name, const int argc, const char **argv) :
+            name_(name), argc(argc), argv(argv)
+        {
+            if (name == nullptr)
+            {
+                throw Celery::Except::Exception("Name cannot be null");
+            }
+        }
+
+        multicall(const multicall &) = delete;
+        multicall &operator=(const multicall &) = delete;
+
+        /**
+         * @brief Strips the directories from a path.
+         */
+        static Celery::Str::External basename(const char *path)
+        {
+            const size_t len = strlen(path);
+            size_t start = len;
+            while (start > 0 && path[start - 1] != '/')
+            {
+                --start;
+            }
+
+            return Celery::Str::External(path + start, len - start);
+        }
+
+        /**
+         * @brief Registers a tool.
+         * @param name The name of the tool, as in the symlink it is invoked through.
+         * @param description The description of the tool.
+         * @param registrar Registers the commands and flags of the tool on
+         *                  its app. Only called for the tool `dispatch()` selects.
+         */
+        void add(
+            const char *name,
+            const char *description,
+            std::function<void(app &)> registrar
+        )
+        {
+            if (name == nullptr || description == nullptr)
+            {
+                throw Celery::Except::Exception("Name and description cannot be null");
+            }
+
+            const Celery::Str::External tool(name, strlen(name));
+            for (const auto &existing : names)
+            {
+                if (Celery::Misc::StringEquality()(existing, tool))
+                {
+                    throw Celery::Except::Exception("Tool already exists");
+                }
+            }
+
+            names.push_back(tool);
+            tools.push_back(tool_spec{description, std::move(registrar)});
+            stale = true;
+        }
+
+        /**
+         * @brief Selects the tool the binary was invoked as.
+         *
+         * When invoked under its own name, the first argument names the
+         * tool instead, and the tool's app only sees the arguments after it.
+         * The app is built and filled in by the tool's registrar here.
+         *
+         * @return The app of the tool, owned by this object, or `nullptr`
+         *         if there is no such tool. The unknown name is then left
+         *         in the global error.
+         */
+        [[nodiscard]] app *dispatch()
+        {
+            global_error = error();
+            if (argc < 1)
+            {
+                global_error.error_type = error::UNKNOWN_COMMAND;
+                return nullptr;
+            }
+
+            auto tool = basename(argv[0]);
+            size_t pos = 0;
+            if (Celery::Misc::StringEquality()(tool, Celery::Str::External(name_)))
+            {
+                if (argc < 2)
+                {
+                    global_error.error_type = error::UNKNOWN_COMMAND;
+                    return nullptr;
+                }
+
+                tool = Celery::Str::External(argv[1]);
+                pos = 1;
+            }
+
+            const size_t i = find(tool);
+            if (i == perfect_hash::NONE)
+            {
+                global_error.error_type = error::UNKNOWN_COMMAND;
+                global_error.argv_pos = pos;
+                global_error.source = tool;
+                return nullptr;
+            }
+
+            // The tool name becomes the program name
+            const auto &spec = tools[i];
+            selected.reset();
+            selected.emplace(names[i].Ptr(), spec.description, argc - pos, argv + pos);
+
+            if (spec.registrar)
+            {
+                spec.registrar(*selected);
+            }
+
+            return &*selected;
+        }
+
+        /**
+         * @brief Builds a message listing the available tools.
+         */
+        template <bool Unicode = true>
+        [[nodiscard]] Celery::Str::String help() const
+        {
+            Celery::Str::String msg;
+            if (global_error.source.Size() != 0)
+            {
+                msg.Write(Celery::Misc::Ansi::Bold::Bright::Red, 7);
+                msg.Write("Error: ", 7);
+                msg.Write(Celery::Misc::Ansi::Reset, 4);
+                msg.Write(Celery::Misc::Ansi::Bright::Red, 5);
+                msg.Write("Unknown tool ", 13);
+                msg.Write(global_error.source.Ptr(), global_error.source.Size());
+                msg.Write(Celery::Misc::Ansi::Reset, 4);
+                msg.Write("\n\n", 2);
+            }
+
+            msg.Write(Celery::Misc::Ansi::Yellow, 5);
+            msg.Write("Available tools:\n", 17);
+            msg.Write(Celery::Misc::Ansi::Reset, 4);
+
+            for (size_t i = 0; i < tools.size(); ++i)
+            {
+                msg.Write(Celery::Misc::Ansi::Bright::Black, 5);
+                msg.Write("  ", 2);
+                if constexpr (Unicode)
+                {
+                    msg.Write("➤ ");
+                }
+                else
+                {
+                    msg.Write("> ", 2);
+                }
+                msg.Write(Celery::Misc::Ansi::Reset, 4);
+                msg.Write(Celery::Misc::Ansi::Cyan, 5);
+                msg.Write(names[i].Ptr(), names[i].Size());
+                msg.Write(Celery::Misc::Ansi::Reset, 4);
+                msg.Write(Celery::Misc::Ansi::Bright::Black, 5);
+                msg.Write(" ~ ", 3);
+                msg.Write(tools[i].description);
+                msg.Write(Celery::Misc::Ansi::Reset, 4);
+                msg.Write('\n');
+            }
+
+            return msg;
+        }
+    };
+}
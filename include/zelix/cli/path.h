@@ -0,0 +1,293 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/24/25.
+//
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <thread>
+#include <vector>
+#include "celery/string/external.h"
+#include "celery/string/string.h"
+#include "error.h"
+#include "traits.h"
+#include "value.h"
+
+namespace zelix::cli
+{
+    /**
+     * @brief A filesystem path given as a command or flag value.
+     *
+     * Like strings, paths are slices of argv, the environment or the
+     * configuration file and are not null-terminated.
+     */
+    class path
+    {
+        const char *ptr = "";
+        size_t size = 0;
+
+    public:
+        explicit path() = default;
+
+        explicit path(const char *str) :
+            ptr(str), size(strlen(str))
+        {}
+
+        explicit path(const Celery::Str::External &str) :
+            ptr(str.Ptr()), size(str.Size())
+        {}
+
+        [[nodiscard]] Celery::Str::External str() const
+        {
+            return Celery::Str::External(ptr, size);
+        }
+    };
+
+    template <>
+    struct value_traits<path>
+    {
+        static constexpr auto kind = value::CUSTOM;
+
+        static bool parse(const Celery::Str::External &text, path &out)
+        {
+            out = path(text);
+            return true;
+        }
+
+        static void describe(const path &, Celery::Str::String &out)
+        {
+            out.Write("path", 4);
+        }
+
+        static void format(const path &val, Celery::Str::String &out)
+        {
+            const auto str = val.str();
+            out.Write(str.Ptr(), str.Size());
+        }
+    };
+
+    /**
+     * @brief What a path value must point to, see `app::check_path()`.
+     */
+    class path_check
+    {
+    public:
+        enum type : uint8_t
+        {
+            NONE,
+            EXISTS, ///< Anything that exists
+            FILE, ///< A regular file
+            DIRECTORY, ///< A directory
+        };
+    };
+
+    /**
+     * @brief Paths waiting to be checked once parsing is done.
+     *
+     * Checking is one `statx()` per path, asking only for the file
+     * type, spread over a few threads so slow (e.g. network-backed)
+     * filesystems are queried concurrently instead of one path at a time.
+     */
+    class path_batch
+    {
+    public:
+        class job
+        {
+        public:
+            size_t offset = 0; ///< Offset of the path in the arena
+            path_check::type check = path_check::NONE;
+            size_t argv_pos = 0; ///< Where the path came from, for error reporting
+            Celery::Str::External origin; ///< Variable or key the path came from, if not argv
+        };
+
+        static constexpr size_t NONE = SIZE_MAX;
+        static constexpr size_t MAX_THREADS = 8;
+        static constexpr size_t JOBS_PER_THREAD = 16; ///< Smaller batches are not worth a thread
+
+    private:
+        std::vector<char> arena; ///< Null-terminated copies of every path
+        std::vector<job> jobs;
+        std::vector<uint8_t> results; ///< Error of each job, as an `error::type`
+
+        [[nodiscard]] error::type check(const job &j) const
+        {
+            const char *file = arena.data() + j.offset;
+            mode_t mode;
+
+#ifdef STATX_TYPE
+            struct statx st{};
+            if (statx(AT_FDCWD, file, AT_STATX_SYNC_AS_STAT, STATX_TYPE, &st) != 0)
+            {
+                return error::PATH_NOT_FOUND;
+            }
+
+            mode = st.stx_mode;
+#else
+            struct stat st{};
+            if (stat(file, &st) != 0)
+            {
+                return error::PATH_NOT_FOUND;
+            }
+
+            mode = st.st_mode;
+#endif
+
+            if (j.check == path_check::FILE && !S_ISREG(mode))
+            {
+                return error::NOT_A_FILE;
+            }
+
+            if (j.check == path_check::DIRECTORY && !S_ISDIR(mode))
+            {
+                return error::NOT_A_DIRECTORY;
+            }
+
+            return error::UNKNOWN;
+        }
+
+    public:
+        /**
+         * @brief Queues a path.
+         * @return The index of the job.
+         */
+        size_t add(
+            const Celery::Str::External &text,
+            const path_check::type check,
+            const size_t argv_pos,
+            const Celery::Str::External &origin
+        )
+        {
+            // Slices of the configuration file are not null-terminated
+            jobs.push_back(job{arena.size(), check, argv_pos, origin});
+            arena.insert(arena.end(), text.Ptr(), text.Ptr() + text.Size());
+            arena.push_back('\0');
+            return jobs.size() - 1;
+        }
+
+        /**
+         * @brief Points a queued job at another path, e.g. for a flag given twice.
+         */
+        void replace(
+            const size_t index,
+            const Celery::Str::External &text,
+            const size_t argv_pos,
+            const Celery::Str::External &origin
+        )
+        {
+            auto &j = jobs[index];
+            j.offset = arena.size();
+            j.argv_pos = argv_pos;
+            j.origin = origin;
+            arena.insert(arena.end(), text.Ptr(), text.Ptr() + text.Size());
+            arena.push_back('\0');
+        }
+
+        void clear()
+        {
+            arena.clear();
+            jobs.clear();
+        }
+
+        [[nodiscard]] bool empty() const
+        {
+            return jobs.empty();
+        }
+
+        [[nodiscard]] const job &at(const size_t index) const
+        {
+            return jobs[index];
+        }
+
+        /**
+         * @brief Checks every queued path.
+         * @return The index of the first job that failed, or `NONE`.
+         */
+        size_t run()
+        {
+            results.assign(jobs.size(), error::UNKNOWN);
+            std::atomic<size_t> next = 0;
+
+            const auto worker = [&]
+            {
+                for (size_t i = next++; i < jobs.size(); i = next++)
+                {
+                    results[i] = check(jobs[i]);
+                }
+            };
+
+            const size_t threads = std::min(
+                MAX_THREADS,
+                (jobs.size() + JOBS_PER_THREAD - 1) / JOBS_PER_THREAD
+            );
+
+            if (threads <= 1)
+            {
+                worker();
+            }
+            else
+            {
+                // The calling thread works too
+                std::vector<std::thread> pool;
+                pool.reserve(threads - 1);
+                for (size_t i = 1; i < threads; ++i)
+                {
+                    pool.emplace_back(worker);
+                }
+
+                worker();
+                for (auto &thread : pool)
+                {
+                    thread.join();
+                }
+            }
+
+            // Report the earliest failure, regardless of which thread found it
+            for (size_t i = 0; i < results.size(); ++i)
+            {
+                if (results[i] != error::UNKNOWN)
+                {
+                    return i;
+                }
+            }
+
+            return NONE;
+        }
+
+        /**
+         * @brief Gets the error of a job, after `run()`.
+         */
+        [[nodiscard]] error::type result(const size_t index) const
+        {
+            return static_cast<error::type>(results[index]);
+        }
+    };
+}
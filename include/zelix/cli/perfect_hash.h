@@ -0,0 +1,297 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/14/25.
+//
+
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "celery/except/base.h"
+#include "celery/string/external.h"
+#include "hash.h"
+
+namespace zelix::cli
+{
+    /**
+     * @brief Collision-free lookup table over a fixed set of strings.
+     *
+     * Built once at registration time by searching for a seed under
+     * which every key lands in its own bucket. Lookups then cost one
+     * hash and a single length + `memcmp()` check, no probing and no
+     * `strcmp()` chains.
+     *
+     * Such a seed gets unlikely as the set grows (a few hundred keys),
+     * so large sets fall back to linear probing over the same table.
+     */
+    class perfect_hash
+    {
+        const Celery::Str::External *keys = nullptr;
+        uint64_t seed = 0;
+        size_t mask = 0;
+        bool probing = false; ///< Whether keys may sit past their bucket
+        std::vector<uint32_t> table; ///< Bucket -> key index + 1, 0 if empty
+        const uint32_t *external = nullptr; ///< Buckets kept elsewhere, e.g. in a frozen schema
+
+        [[nodiscard]] size_t bucket(const Celery::Str::External &key) const
+        {
+            return fnv1a(seed).update(key.Ptr(), key.Size()).digest() & mask;
+        }
+
+        bool try_seed(const uint32_t *ids, const size_t count)
+        {
+            std::fill(table.begin(), table.end(), 0);
+            for (size_t i = 0; i < count; ++i)
+            {
+                auto &slot = table[bucket(keys[ids[i]])];
+                if (slot != 0)
+                {
+                    return false;
+                }
+
+                slot = ids[i] + 1;
+            }
+
+            return true;
+        }
+
+        [[nodiscard]] bool matches(const uint32_t slot, const Celery::Str::External &key) const
+        {
+            const auto &candidate = keys[slot - 1];
+            return candidate.Size() == key.Size()
+                && memcmp(candidate.Ptr(), key.Ptr(), key.Size()) == 0;
+        }
+
+        static bool less(const Celery::Str::External &a, const Celery::Str::External &b)
+        {
+            if (a.Size() != b.Size())
+            {
+                return a.Size() < b.Size();
+            }
+
+            return memcmp(a.Ptr(), b.Ptr(), a.Size()) < 0;
+        }
+
+        /**
+         * @brief Throws if a key is given twice, which no table could tell apart.
+         */
+        void check_unique(const uint32_t *ids, const size_t count) const
+        {
+            std::vector<const Celery::Str::External *> sorted(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                sorted[i] = keys + ids[i];
+            }
+
+            std::sort(sorted.begin(), sorted.end(), [](const auto *a, const auto *b)
+            {
+                return less(*a, *b);
+            });
+
+            for (size_t i = 1; i < count; ++i)
+            {
+                if (!less(*sorted[i - 1], *sorted[i]))
+                {
+                    throw Celery::Except::Exception("Duplicate keys in perfect hash");
+                }
+            }
+        }
+
+        void build_probing(const uint32_t *ids, const size_t count)
+        {
+            probing = true;
+            seed = 0;
+
+            size_t size = 1;
+            while (size < count * 2)
+            {
+                size <<= 1;
+            }
+
+            table.assign(size, 0);
+            mask = size - 1;
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                size_t pos = bucket(keys[ids[i]]);
+                while (table[pos] != 0)
+                {
+                    pos = (pos + 1) & mask;
+                }
+
+                table[pos] = ids[i] + 1;
+            }
+        }
+
+        void build(const uint32_t *ids, const size_t count)
+        {
+            check_unique(ids, count);
+
+            size_t size = 1;
+            while (size < count * 2)
+            {
+                size <<= 1;
+            }
+
+            // Grow the table whenever a batch of seeds fails
+            while (true)
+            {
+                table.assign(size, 0);
+                mask = size - 1;
+
+                for (size_t attempt = 0; attempt < 64; ++attempt, ++seed)
+                {
+                    if (try_seed(ids, count))
+                    {
+                        return;
+                    }
+                }
+
+                // Keep the table small rather than searching forever
+                if (size >= count * 16)
+                {
+                    build_probing(ids, count);
+                    return;
+                }
+
+                size <<= 1;
+            }
+        }
+
+    public:
+        static constexpr size_t NONE = SIZE_MAX;
+
+        explicit perfect_hash() = default;
+
+        /**
+         * @brief Builds the table.
+         * @param keys The keys, which must outlive the table and be unique.
+         * @param count The number of keys.
+         */
+        explicit perfect_hash(const Celery::Str::External *keys, const size_t count) :
+            keys(keys)
+        {
+            std::vector<uint32_t> ids(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                ids[i] = static_cast<uint32_t>(i);
+            }
+
+            build(ids.data(), count);
+        }
+
+        /**
+         * @brief Builds the table over some of the keys.
+         *
+         * Lookups return indices into `keys`, e.g. the slots of the
+         * flags when `keys` holds the names of every slot.
+         *
+         * @param keys The keys, which must outlive the table.
+         * @param ids The indices of the keys to add, which must be unique.
+         * @param count The number of indices.
+         */
+        explicit perfect_hash(const Celery::Str::External *keys, const uint32_t *ids, const size_t count) :
+            keys(keys)
+        {
+            build(ids, count);
+        }
+
+        /**
+         * @brief Uses a table built elsewhere, see `buckets()`.
+         * @param keys The keys the table was built over, which must outlive it.
+         * @param buckets The buckets, which must outlive the table.
+         * @param size The number of buckets, a power of two.
+         */
+        explicit perfect_hash(
+            const Celery::Str::External *keys,
+            const uint64_t seed,
+            const bool probing,
+            const uint32_t *buckets,
+            const size_t size
+        ) :
+            keys(keys), seed(seed), mask(size - 1), probing(probing), external(buckets)
+        {
+        }
+
+        [[nodiscard]] uint64_t get_seed() const
+        {
+            return seed;
+        }
+
+        [[nodiscard]] bool is_probing() const
+        {
+            return probing;
+        }
+
+        /**
+         * @brief Gets the buckets, each holding a key index + 1, or 0 if empty.
+         */
+        [[nodiscard]] const uint32_t *buckets() const
+        {
+            return external != nullptr ? external : table.data();
+        }
+
+        [[nodiscard]] size_t size() const
+        {
+            return external != nullptr || !table.empty() ? mask + 1 : 0;
+        }
+
+        /**
+         * @brief Finds a key.
+         * @return The index of the key, or `NONE`.
+         */
+        [[nodiscard]] size_t find(const Celery::Str::External &key) const
+        {
+            if (size() == 0)
+            {
+                return NONE;
+            }
+
+            const uint32_t *slots = buckets();
+            size_t pos = bucket(key);
+            if (!probing)
+            {
+                const uint32_t slot = slots[pos];
+                return slot != 0 && matches(slot, key) ? slot - 1 : NONE;
+            }
+
+            // Tables are at most half full, so there is always an empty bucket
+            while (slots[pos] != 0)
+            {
+                if (matches(slots[pos], key))
+                {
+                    return slots[pos] - 1;
+                }
+
+                pos = (pos + 1) & mask;
+            }
+
+            return NONE;
+        }
+    };
+}
@@ -0,0 +1,565 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/10/25.
+//
+
+#pragma once
+#include <algorithm>
+#include <cstring>
+#include "celery/string/external.h"
+#include "error.h"
+#include "schema.h"
+#include "value.h"
+#include "view.h"
+
+namespace zelix::cli
+{
+    /**
+     * @brief A single token of a command line, as seen by the parser.
+     */
+    class event
+    {
+    public:
+        enum type
+        {
+            COMMAND, ///< The command was selected
+            FLAG, ///< A flag was given; boolean flags are set by this alone
+            VALUE, ///< The value of the last command or flag
+            DEFAULT, ///< The last command or flag is missing its value at the end of argv
+            POSITIONAL, ///< An argument for a positional
+            PASSTHROUGH, ///< Everything after the "--" terminator
+            SEPARATOR, ///< The delimiter between chained commands, see `reader::chain()`
+            ERROR, ///< Parsing failed, see `error_type`
+        };
+
+        type event_type = ERROR; ///< Type of the event
+        size_t slot = 0; ///< Slot of the command or flag, or index of the positional
+        size_t argv_pos = 0; ///< Position in the argv array of the token
+        bool command = false; ///< For values, whether they belong to the command
+
+        Celery::Str::External name = Celery::Str::External("", 0); ///< Registered name of the command, flag or positional
+        Celery::Str::External text = Celery::Str::External("", 0); ///< Raw value, for values and positionals
+        const value *val = nullptr; ///< Registered value of the command or flag
+        argv_view rest; ///< Arguments after the terminator, for passthrough events
+
+        error::type error_type = error::UNKNOWN; ///< Error, for error events
+    };
+
+    /**
+     * @brief Pull-based, zero-copy parser.
+     *
+     * This is the state machine behind `args::parse`, exposed so callers
+     * can dispatch on the tokens of a command line directly instead of
+     * having `args` fill its maps:
+     *
+     * ```c++
+     * cli::reader reader = app.events();
+     * cli::event ev;
+     *
+     * while (reader.next(ev))
+     * {
+     *     switch (ev.event_type)
+     *     {
+     *         case cli::event::FLAG: ...
+     *     }
+     * }
+     * ```
+     *
+     * The reader never converts values or allocates; every slice points
+     * into argv. An `ERROR` event is always the last one.
+     */
+    class reader
+    {
+        const schema &schema_;
+        const int argc;
+        const char **argv;
+        const size_t *lens;
+
+        int i = 1; ///< Next token to read
+        bool done = false;
+        bool bounded = false; ///< Whether argv was checked against the schema limits
+        bool terminated = false; ///< Whether the "--" terminator was read
+
+        bool has_command = false;
+        size_t command_slot = SIZE_MAX; ///< Slot of the selected command
+        bool waiting_value = false; ///< Whether the next token is the value of `owner`
+        event owner; ///< The command or flag waiting for a value
+        bool has_inline = false; ///< Whether `inline_value` is yet to be returned
+        event inline_value; ///< Value given with `--flag=value`
+
+        size_t next_positional = 0; ///< Index of the next positional to fill
+        int variadic_end = -1; ///< Position right after the last variadic argument
+
+        Celery::Str::External delimiter = Celery::Str::External("", 0); ///< Separates chained commands, if any
+
+        [[nodiscard]] bool is_delimiter(const int pos) const
+        {
+            const size_t size = delimiter.Size();
+            if (size == 0 || argv[pos][0] != delimiter.Ptr()[0])
+            {
+                return false;
+            }
+
+            return (lens == nullptr ? strlen(argv[pos]) : lens[pos]) == size
+                && memcmp(argv[pos], delimiter.Ptr(), size) == 0;
+        }
+
+        /**
+         * @brief Checks argv against the schema limits.
+         * @return The position of the first token past a limit, or `-1`.
+         */
+        [[nodiscard]] int exceeds_limits() const
+        {
+            const auto &limits = schema_.limits;
+            if (limits.tokens != 0 && static_cast<size_t>(argc - 1) > limits.tokens)
+            {
+                return static_cast<int>(limits.tokens) + 1;
+            }
+
+            if (limits.token_length == 0 && limits.total_bytes == 0)
+            {
+                return -1;
+            }
+
+            size_t total = 0;
+            for (int pos = 1; pos < argc; ++pos)
+            {
+                // Never scan further than the tightest limit allows
+                size_t bound = limits.token_length != 0 ? limits.token_length : SIZE_MAX - 1;
+                if (limits.total_bytes != 0)
+                {
+                    bound = std::min(bound, limits.total_bytes - total);
+                }
+
+                const size_t len = lens == nullptr ? strnlen(argv[pos], bound + 1) : lens[pos];
+                total += len;
+
+                if (
+                    (limits.token_length != 0 && len > limits.token_length)
+                    || (limits.total_bytes != 0 && total > limits.total_bytes)
+                )
+                {
+                    return pos;
+                }
+            }
+
+            return -1;
+        }
+
+        [[nodiscard]] Celery::Str::External token(const int pos, const size_t skip = 0) const
+        {
+            return lens == nullptr
+                ? Celery::Str::External(argv[pos] + skip)
+                : Celery::Str::External(argv[pos] + skip, lens[pos] - skip);
+        }
+
+        bool fail(event &out, const error::type type, const size_t pos)
+        {
+            done = true;
+            out.event_type = event::ERROR;
+            out.error_type = type;
+            out.argv_pos = pos;
+            return true;
+        }
+
+        bool read_flag(event &out, Celery::Str::External flag)
+        {
+            // Check if we have a value
+            Celery::Str::External val;
+            const auto flag_ptr = flag.Ptr();
+            const auto equals = static_cast<const char *>(
+                memchr(flag_ptr, '=', flag.Size())
+            );
+
+            if (equals != nullptr)
+            {
+                const size_t equals_pos = equals - flag_ptr;
+                val = Celery::Str::External(
+                    flag_ptr + equals_pos + 1, // Skip the equals sign
+                    flag.Size() - equals_pos - 1
+                );
+
+                flag = Celery::Str::External(flag_ptr, equals_pos); // Exclude the equals sign
+            }
+
+            // Handle aliases
+            size_t slot = schema_.find_flag_alias(flag);
+            if (slot == schema::NONE)
+            {
+                slot = schema_.find_flag(flag);
+            }
+
+            if (slot == schema::NONE)
+            {
+                return fail(out, error::UNKNOWN_FLAG, i);
+            }
+
+            // Flags registered by a command only exist under it
+            if (
+                const size_t flag_owner = schema_.owners[slot];
+                flag_owner != SIZE_MAX && flag_owner != command_slot
+            )
+            {
+                return fail(out, error::UNKNOWN_FLAG, i);
+            }
+
+            const auto &flag_val = schema_.values[slot];
+            out.event_type = event::FLAG;
+            out.slot = slot;
+            out.argv_pos = i;
+            out.command = false;
+            out.name = schema_.slot_names[slot];
+            out.val = &flag_val;
+
+            const bool expects_value = flag_val.get_type() != value::BOOL;
+            if (equals == nullptr)
+            {
+                waiting_value = expects_value;
+                owner = out;
+                return true;
+            }
+
+            if (!expects_value)
+            {
+                return fail(out, error::NOT_EXPECTED_VALUE, i);
+            }
+
+            if (val.Size() == 0)
+            {
+                return fail(out, error::EXPECTED_VALUE, i);
+            }
+
+            // Return the value right after the flag
+            inline_value = out;
+            inline_value.event_type = event::VALUE;
+            inline_value.text = val;
+            has_inline = true;
+            return true;
+        }
+
+        bool read_command(event &out)
+        {
+            auto cmd = token(i);
+
+            // Handle aliases
+            size_t slot = schema_.find_command_alias(cmd);
+            if (slot == schema::NONE)
+            {
+                slot = schema_.find_command(cmd);
+            }
+
+            // Check if the command is valid
+            if (slot == schema::NONE)
+            {
+                return fail(out, error::UNKNOWN_COMMAND, i);
+            }
+
+            const auto &cmd_val = schema_.values[slot];
+            has_command = true;
+            command_slot = slot;
+            out.event_type = event::COMMAND;
+            out.slot = slot;
+            out.argv_pos = i;
+            out.command = true;
+            out.name = schema_.slot_names[slot]; // The original ptr
+            out.val = &cmd_val;
+
+            waiting_value = cmd_val.get_type() != value::BOOL;
+            owner = out;
+            return true;
+        }
+
+        bool read_positional(event &out)
+        {
+            if (next_positional < schema_.positionals.size())
+            {
+                const bool variadic = schema_.positionals[next_positional].variadic;
+
+                // Variadic positionals are a single contiguous run,
+                // so they can be handed out as a view over argv
+                if (!variadic || variadic_end == -1 || variadic_end == i)
+                {
+                    out.event_type = event::POSITIONAL;
+                    out.slot = next_positional;
+                    out.argv_pos = i;
+                    out.name = schema_.positionals[next_positional].name;
+                    out.text = token(i);
+
+                    if (variadic)
+                    {
+                        variadic_end = i + 1;
+                    }
+                    else
+                    {
+                        ++next_positional;
+                    }
+
+                    return true;
+                }
+
+                // Something else came in between, e.g. a flag
+                if (variadic)
+                {
+                    out.name = schema_.positionals[next_positional].name;
+                    return fail(out, error::SPLIT_VARIADIC, i);
+                }
+            }
+
+            // Invalid argument
+            return fail(out, error::NOT_EXPECTED_VALUE, i);
+        }
+
+    public:
+        /**
+         * @brief Reader state between two tokens, see `args::reparse()`.
+         */
+        class checkpoint
+        {
+        public:
+            int pos = 1; ///< Next token to read
+            bool has_command = false;
+            size_t command_slot = SIZE_MAX;
+            bool waiting_value = false; ///< Whether the token is the value of the last command or flag
+            size_t next_positional = 0;
+            int variadic_end = -1;
+        };
+
+        explicit reader(
+            const schema &schema_,
+            const int argc,
+            const char **argv,
+            const size_t *lens = nullptr
+        ) :
+            schema_(schema_), argc(argc), argv(argv), lens(lens)
+        {}
+
+        /**
+         * @brief Splits the command line into several commands.
+         *
+         * Each `delimiter` token ends the current command with a
+         * `SEPARATOR` event, after which a new command is read
+         * against the same schema. Delimiters after the "--"
+         * terminator are passed through.
+         *
+         * @param delimiter The token between commands, e.g. "+".
+         */
+        reader &chain(const Celery::Str::External &delimiter)
+        {
+            this->delimiter = delimiter;
+            return *this;
+        }
+
+        /**
+         * @brief Whether the whole command line was read, or parsing failed.
+         */
+        [[nodiscard]] bool finished() const
+        {
+            return done;
+        }
+
+        [[nodiscard]] const char **get_argv() const
+        {
+            return argv;
+        }
+
+        /**
+         * @brief Gets the position of the next token to read.
+         */
+        [[nodiscard]] int position() const
+        {
+            return i;
+        }
+
+        /**
+         * @brief Whether the reader is between two tokens, so it can be saved.
+         */
+        [[nodiscard]] bool between_tokens() const
+        {
+            return !has_inline && !done && !terminated;
+        }
+
+        [[nodiscard]] checkpoint save() const
+        {
+            return checkpoint{i, has_command, command_slot, waiting_value, next_positional, variadic_end};
+        }
+
+        /**
+         * @brief Resumes reading from a checkpoint, possibly taken over another argv.
+         *
+         * The tokens before the checkpoint must be the same in both argvs.
+         *
+         * @param point The checkpoint.
+         * @param waiting_for The command or flag waiting for a value, if the checkpoint is.
+         */
+        void restore(const checkpoint &point, const event &waiting_for)
+        {
+            i = point.pos;
+            done = false;
+            bounded = false; // The new argv is checked in full
+            terminated = false;
+            has_command = point.has_command;
+            command_slot = point.command_slot;
+            waiting_value = point.waiting_value;
+            owner = waiting_for;
+            has_inline = false;
+            next_positional = point.next_positional;
+            variadic_end = point.variadic_end;
+        }
+
+        [[nodiscard]] const size_t *get_lens() const
+        {
+            return lens;
+        }
+
+        /**
+         * @brief Reads the next event.
+         * @param out Where to store the event.
+         * @return Whether an event was read.
+         */
+        bool next(event &out)
+        {
+            out = event();
+
+            if (done)
+            {
+                return false;
+            }
+
+            if (has_inline)
+            {
+                has_inline = false;
+                out = inline_value;
+                return true;
+            }
+
+            if (argc < 2 || argv == nullptr)
+            {
+                return fail(out, error::EXPECTED_VALUE, 0);
+            }
+
+            // Chained commands share the reader, so this runs once per argv
+            if (!bounded)
+            {
+                bounded = true;
+                if (const int pos = exceeds_limits(); pos >= 0)
+                {
+                    return fail(out, error::LIMIT_EXCEEDED, pos);
+                }
+            }
+
+            if (i >= argc || is_delimiter(i))
+            {
+                // Make sure we got a command
+                if (!has_command)
+                {
+                    return fail(out, error::EXPECTED_VALUE, i >= argc ? argc - 1 : i);
+                }
+
+                // Values missing at the very end fall back to their defaults
+                if (waiting_value)
+                {
+                    waiting_value = false;
+                    out = owner;
+                    out.event_type = event::DEFAULT;
+                    return true;
+                }
+
+                if (i >= argc)
+                {
+                    done = true;
+                    return false;
+                }
+
+                // Start over for the next command
+                out.event_type = event::SEPARATOR;
+                out.argv_pos = i;
+                ++i;
+
+                has_command = false;
+                command_slot = SIZE_MAX;
+                next_positional = 0;
+                variadic_end = -1;
+                return true;
+            }
+
+            const auto arg = argv[i];
+            if (waiting_value)
+            {
+                waiting_value = false;
+                out = owner;
+                out.event_type = event::VALUE;
+                out.argv_pos = i;
+                out.text = token(i);
+                ++i;
+                return true;
+            }
+
+            bool ok;
+
+            // Check if we have a flag
+            if (arg[0] == '-')
+            {
+                // Check if the flag is valid
+                if (arg[1] == '\0')
+                {
+                    return fail(out, error::UNKNOWN_FLAG, i);
+                }
+
+                // A bare "--" ends the options, everything after
+                // it is handed out untouched
+                if (arg[1] == '-' && arg[2] == '\0')
+                {
+                    out.event_type = event::PASSTHROUGH;
+                    out.argv_pos = i + 1;
+                    out.rest = argv_view(
+                        argv + i + 1,
+                        argv + argc,
+                        i + 1,
+                        lens == nullptr ? nullptr : lens + i + 1
+                    );
+
+                    i = argc; // The next call finishes up
+                    terminated = true;
+                    return true;
+                }
+
+                ok = read_flag(out, token(i, arg[1] == '-' ? 2 : 1));
+            }
+            else if (!has_command)
+            {
+                ok = read_command(out);
+            }
+            else
+            {
+                ok = read_positional(out);
+            }
+
+            ++i;
+            return ok;
+        }
+    };
+}
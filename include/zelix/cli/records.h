@@ -0,0 +1,394 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/8/25.
+//
+
+#pragma once
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace zelix::cli
+{
+    /**
+     * @brief Reader for NUL-separated argument records.
+     *
+     * Reads argument vectors in the format used by `/proc/<pid>/cmdline`
+     * and `xargs -0`, where every argument is terminated by a NUL byte.
+     * By default the whole input is a single invocation, and empty
+     * records are empty arguments (`prog "" x` is `prog\0\0x\0`).
+     * Several invocations can be stored back to back by choosing a
+     * `framing`.
+     *
+     * Since the boundaries of every record are known, the argument
+     * vectors point straight into the data and come with their lengths,
+     * so they can be parsed without any `strlen()` calls or copies:
+     *
+     * ```c++
+     * cli::records rec;
+     * rec.read(fd);
+     *
+     * while (rec.next())
+     * {
+     *     cli::args args = app.parse(rec.argc(), rec.argv(), rec.lens());
+     *     // ...
+     * }
+     * ```
+     *
+     * The pointer and length arrays are reused between invocations.
+     */
+    class records
+    {
+    public:
+        /**
+         * @brief How invocations are delimited.
+         */
+        enum framing
+        {
+            SINGLE, ///< The whole input is one invocation
+            COUNTED, ///< Every invocation starts with a record holding its number of arguments, in decimal
+            EMPTY_RECORD, ///< Invocations end with an empty record, so arguments can't be empty
+        };
+
+    private:
+        const char *data = nullptr;
+        size_t size = 0;
+        size_t cursor = 0; ///< Offset of the next record
+        framing frame = SINGLE;
+        bool malformed_ = false; ///< Whether a count record was invalid or too large
+
+        bool mapped = false;
+        std::vector<char> buffer; ///< Storage for data read from file descriptors
+
+        const char *program = nullptr; ///< argv[0] for streams that don't carry it
+        size_t program_len = 0;
+
+        std::vector<const char *> argv_;
+        std::vector<size_t> lens_;
+
+        void reset(const char *ptr, const size_t len)
+        {
+            data = ptr;
+            size = len;
+            cursor = 0;
+            malformed_ = false;
+        }
+
+        /**
+         * @brief Reads the record at the cursor, and moves past it.
+         */
+        size_t take(const char *&record)
+        {
+            record = data + cursor;
+            const auto end = static_cast<const char *>(
+                memchr(record, '\0', size - cursor)
+            );
+
+            // The terminator of an unterminated last record lies
+            // right past the end (see map() and read())
+            const size_t len = end == nullptr ? size - cursor : end - record;
+            cursor += len + 1;
+            return len;
+        }
+
+        /**
+         * @brief Reads the argument count that starts an invocation.
+         */
+        bool take_count(size_t &count)
+        {
+            const char *record;
+            const size_t len = take(record);
+            if (len == 0 || len > 9)
+            {
+                return false;
+            }
+
+            count = 0;
+            for (size_t i = 0; i < len; ++i)
+            {
+                if (record[i] < '0' || record[i] > '9')
+                {
+                    return false;
+                }
+
+                count = count * 10 + (record[i] - '0');
+            }
+
+            return true;
+        }
+
+    public:
+        explicit records() = default;
+
+        records(const records &) = delete;
+        records &operator=(const records &) = delete;
+
+        ~records()
+        {
+            close();
+        }
+
+        /**
+         * @brief Uses a caller-owned region as the input.
+         * @param ptr The records. The last one must be NUL-terminated.
+         * @param len The size of the region.
+         */
+        void assign(const char *ptr, const size_t len)
+        {
+            close();
+            reset(ptr, len);
+        }
+
+        /**
+         * @brief Reads every record from a file descriptor.
+         *
+         * Works for pipes and for pseudo-files such as `/proc/<pid>/cmdline`
+         * that can't be mapped. The buffer is reused between calls.
+         *
+         * @param fd The file descriptor, read until EOF.
+         * @return Whether the data could be read.
+         */
+        bool read(const int fd)
+        {
+            close();
+            buffer.clear();
+
+            size_t used = 0;
+            while (true)
+            {
+                if (buffer.size() - used < 4096)
+                {
+                    buffer.resize(buffer.size() + 65536);
+                }
+
+                const ssize_t n = ::read(fd, buffer.data() + used, buffer.size() - used);
+                if (n < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+
+                    return false;
+                }
+
+                if (n == 0)
+                {
+                    break;
+                }
+
+                used += n;
+            }
+
+            // Make sure the last record is terminated
+            if (used != 0 && buffer[used - 1] != '\0')
+            {
+                buffer[used++] = '\0';
+            }
+
+            reset(buffer.data(), used);
+            return true;
+        }
+
+        /**
+         * @brief Memory-maps a file of records.
+         * @param path The path to the file.
+         * @return Whether the file could be read.
+         */
+        bool map(const char *path)
+        {
+            close();
+
+            const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+            {
+                return false;
+            }
+
+            struct stat st{};
+            if (fstat(fd, &st) != 0)
+            {
+                ::close(fd);
+                return false;
+            }
+
+            // Pseudo-files report a size of 0, and a file whose last
+            // record is unterminated and fills the last page exactly
+            // has no room for the terminator; read those instead
+            const auto page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+            const auto len = static_cast<size_t>(st.st_size);
+            void *map = MAP_FAILED;
+
+            if (len != 0)
+            {
+                map = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+            }
+
+            if (
+                map != MAP_FAILED
+                && static_cast<const char *>(map)[len - 1] != '\0'
+                && len % page == 0
+            )
+            {
+                munmap(map, len);
+                map = MAP_FAILED;
+            }
+
+            if (map == MAP_FAILED)
+            {
+                const bool ok = read(fd);
+                ::close(fd);
+                return ok;
+            }
+
+            ::close(fd); // The mapping keeps the file alive
+
+            // The rest of the last page is zero-filled, which
+            // terminates the last record if needed
+            mapped = true;
+            reset(static_cast<const char *>(map), len);
+            return true;
+        }
+
+        void close()
+        {
+            if (mapped)
+            {
+                munmap(const_cast<char *>(data), size);
+                mapped = false;
+            }
+
+            reset(nullptr, 0);
+        }
+
+        /**
+         * @brief Sets the program name to use as argv[0].
+         *
+         * Streams such as `xargs -0` output only carry the arguments, so
+         * the program name has to be supplied separately. Once set, every
+         * record is treated as an argument.
+         */
+        void set_program(const char *name)
+        {
+            program = name;
+            program_len = name == nullptr ? 0 : strlen(name);
+        }
+
+        /**
+         * @brief Sets how invocations are delimited, `SINGLE` by default.
+         *
+         * With `COUNTED`, e.g. `2\0prog\0\0` holds `prog ""`; the count
+         * doesn't include the program name given to `set_program()`.
+         */
+        void set_framing(const framing mode)
+        {
+            frame = mode;
+        }
+
+        /**
+         * @brief Whether reading stopped at an invalid or truncated `COUNTED` invocation.
+         */
+        [[nodiscard]] bool malformed() const
+        {
+            return malformed_;
+        }
+
+        /**
+         * @brief Moves to the next invocation.
+         * @return Whether there was another invocation.
+         */
+        bool next()
+        {
+            argv_.clear();
+            lens_.clear();
+
+            if (cursor >= size || malformed_)
+            {
+                return false;
+            }
+
+            size_t count = SIZE_MAX;
+            if (frame == COUNTED && !take_count(count))
+            {
+                malformed_ = true;
+                return false;
+            }
+
+            if (program != nullptr)
+            {
+                argv_.push_back(program);
+                lens_.push_back(program_len);
+            }
+
+            for (size_t taken = 0; taken < count && cursor < size; ++taken)
+            {
+                const char *record;
+                const size_t len = take(record);
+
+                if (len == 0 && frame == EMPTY_RECORD)
+                {
+                    break;
+                }
+
+                argv_.push_back(record);
+                lens_.push_back(len);
+            }
+
+            if (frame == COUNTED && argv_.size() - (program != nullptr) != count)
+            {
+                malformed_ = true;
+                argv_.clear();
+                lens_.clear();
+                return false;
+            }
+
+            // Keep the vector null-terminated like a real argv
+            argv_.push_back(nullptr);
+            return true;
+        }
+
+        [[nodiscard]] int argc() const
+        {
+            return argv_.empty() ? 0 : static_cast<int>(argv_.size() - 1);
+        }
+
+        [[nodiscard]] const char **argv()
+        {
+            return argv_.data();
+        }
+
+        [[nodiscard]] const size_t *lens() const
+        {
+            return lens_.data();
+        }
+    };
+}
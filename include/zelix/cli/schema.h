@@ -0,0 +1,395 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/2/25.
+//
+
+#pragma once
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "ankerl/unordered_dense.h"
+#include "celery/except/base.h"
+#include "celery/string/external.h"
+#include "celery/misc/hash.h"
+#include "binding.h"
+#include "bitset.h"
+#include "config.h"
+#include "hash.h"
+#include "path.h"
+#include "perfect_hash.h"
+#include "traits.h"
+#include "value.h"
+#include <celery/misc/string_equal.h>
+
+namespace zelix::cli
+{
+#ifdef ZELIX_CLI_SEEDED_HASH
+    using name_hash = seeded_hash; ///< Keyed per process, for untrusted command lines
+#else
+    using name_hash = Celery::Misc::Hash;
+#endif
+
+    template <typename V>
+    using name_map = ankerl::unordered_dense::map<
+        Celery::Str::External,
+        V,
+        name_hash,
+        Celery::Misc::StringEquality
+    >;
+
+    class positional_spec
+    {
+    public:
+        Celery::Str::External name; ///< Name of the positional
+        Celery::Str::External description; ///< Description of the positional
+        bool variadic = false; ///< Whether the positional takes every remaining argument
+    };
+
+    /**
+     * @brief Bounds on the size of a command line, `0` meaning unbounded.
+     */
+    class parse_limits
+    {
+    public:
+        size_t tokens = 0; ///< Arguments after the program name
+        size_t token_length = 0; ///< Bytes in a single argument
+        size_t total_bytes = 0; ///< Bytes in all arguments together
+    };
+
+    /**
+     * @brief Computes a default once, the first time it is needed.
+     */
+    class default_provider
+    {
+    public:
+        std::function<value::storage()> compute;
+        std::once_flag once;
+        value::storage result;
+    };
+
+    class dependency
+    {
+    public:
+        size_t slot = 0; ///< Slot that has the requirement
+        slot_set needs; ///< Slots that must be given along with it
+    };
+
+    /**
+     * @brief Name lookups of a frozen schema, stored in its image.
+     *
+     * The tables are built over slot indices when the schema is frozen,
+     * so thawing it hashes nothing.
+     */
+    class frozen_index
+    {
+    public:
+        perfect_hash commands; ///< Command name -> slot
+        perfect_hash command_aliases; ///< Command alias -> slot
+        perfect_hash flags; ///< Flag name -> slot
+        perfect_hash flag_aliases; ///< Flag alias -> slot
+        perfect_hash positionals; ///< Positional name -> index in `schema::positionals`
+    };
+
+    /**
+     * @brief Everything registered in an `app`, shared with the `args` it produces.
+     */
+    class schema
+    {
+        /**
+         * @brief Finds a name in the maps of a registered schema.
+         */
+        static size_t lookup(const name_map<size_t> &map, const Celery::Str::External &name)
+        {
+            const auto it = map.find(name);
+            return it != map.end() ? it->second : SIZE_MAX;
+        }
+
+    public:
+        static constexpr size_t NONE = SIZE_MAX;
+
+        // Commands and flags (by slot)
+        size_t slots = 0; ///< Number of slots handed out to commands and flags
+        std::vector<value> values;
+        std::vector<Celery::Str::External> slot_names; ///< Command or flag name
+        std::vector<Celery::Str::External> slot_aliases;
+        std::vector<Celery::Str::External> slot_envs; ///< Environment fallback of a flag, empty if none
+        slot_set command_slots; ///< Slots that hold commands
+        std::vector<size_t> env_slots; ///< Flags with an environment fallback, in registration order
+
+        // Lookups of registered schemas (name or alias -> slot)
+        name_map<size_t> command_ids;
+        name_map<size_t> flag_ids;
+        name_map<size_t> command_alias_ids;
+        name_map<size_t> flag_alias_ids;
+
+        const frozen_index *frozen = nullptr; ///< Lookups of the image the schema was thawed from, if any
+
+        // Constraints, checked once argv, the environment and the configuration file are merged
+        slot_set required;
+        std::vector<slot_set> exclusive_groups;
+        std::vector<dependency> dependencies;
+
+        // Destinations flags are written into (slot -> binding)
+        std::vector<binding> bindings;
+        const void *bound_type = nullptr; ///< Class of member bindings, if any
+
+        // Flags registered once their command is selected (command name -> registrar)
+        name_map<std::function<void()>> registrars;
+        std::vector<size_t> owners; ///< Command slot that registered each slot, `SIZE_MAX` for globals
+        size_t loading = SIZE_MAX; ///< Command whose registrar is running
+
+        // Validation of string values and positionals
+        bool check_utf8 = false;
+        bool reject_control = false;
+
+        parse_limits limits; ///< Checked before anything is looked up
+
+        // Paths checked once parsing is done, `path_check::NONE` for other values
+        std::vector<path_check::type> slot_paths; ///< By slot
+        std::vector<path_check::type> positional_paths; ///< By positional
+
+        config_file config; ///< Optional configuration file, merged under argv and the environment
+
+        // Computed defaults, kept apart so that fixed ones pay nothing (by slot, null for fixed)
+        std::vector<std::unique_ptr<default_provider>> providers;
+
+        // Positionals, in declaration order
+        std::vector<positional_spec> positionals;
+        name_map<size_t> positional_ids; ///< Positional name -> index in `positionals`
+
+        /**
+         * @brief Runs the flag registrar of a command, the first time it is selected.
+         * @param command The name of the command.
+         */
+        void load(const Celery::Str::External &command)
+        {
+            if (registrars.empty())
+            {
+                return;
+            }
+
+            const auto it = registrars.find(command);
+            if (it == registrars.end())
+            {
+                return;
+            }
+
+            const auto registrar = std::move(it->second);
+            registrars.erase(it);
+
+            loading = find_command(command);
+            registrar();
+            loading = SIZE_MAX;
+        }
+
+        /**
+         * @brief Finds a command by name.
+         * @return The slot of the command, or `NONE`.
+         */
+        [[nodiscard]] size_t find_command(const Celery::Str::External &name) const
+        {
+            return frozen != nullptr ? frozen->commands.find(name) : lookup(command_ids, name);
+        }
+
+        /**
+         * @brief Finds a command by alias.
+         * @return The slot of the command, or `NONE`.
+         */
+        [[nodiscard]] size_t find_command_alias(const Celery::Str::External &alias) const
+        {
+            return frozen != nullptr ? frozen->command_aliases.find(alias) : lookup(command_alias_ids, alias);
+        }
+
+        /**
+         * @brief Finds a flag by name.
+         * @return The slot of the flag, or `NONE`.
+         */
+        [[nodiscard]] size_t find_flag(const Celery::Str::External &name) const
+        {
+            return frozen != nullptr ? frozen->flags.find(name) : lookup(flag_ids, name);
+        }
+
+        /**
+         * @brief Finds a flag by alias.
+         * @return The slot of the flag, or `NONE`.
+         */
+        [[nodiscard]] size_t find_flag_alias(const Celery::Str::External &alias) const
+        {
+            return frozen != nullptr ? frozen->flag_aliases.find(alias) : lookup(flag_alias_ids, alias);
+        }
+
+        /**
+         * @brief Finds a positional by name.
+         * @return The index of the positional in `positionals`, or `NONE`.
+         */
+        [[nodiscard]] size_t find_positional(const Celery::Str::External &name) const
+        {
+            return frozen != nullptr ? frozen->positionals.find(name) : lookup(positional_ids, name);
+        }
+
+        /**
+         * @brief Gets the registered value of a command, throwing if there is none.
+         */
+        [[nodiscard]] const value &command(const Celery::Str::External &name) const
+        {
+            const size_t slot = find_command(name);
+            if (slot == NONE)
+            {
+                throw Celery::Except::OutOfRange();
+            }
+
+            return values[slot];
+        }
+
+        /**
+         * @brief Gets the registered value of a flag, throwing if there is none.
+         */
+        [[nodiscard]] const value &flag(const Celery::Str::External &name) const
+        {
+            const size_t slot = find_flag(name);
+            if (slot == NONE)
+            {
+                throw Celery::Except::OutOfRange();
+            }
+
+            return values[slot];
+        }
+
+        /**
+         * @brief Gets the index of a positional, throwing if there is none.
+         */
+        [[nodiscard]] size_t positional(const Celery::Str::External &name) const
+        {
+            const size_t index = find_positional(name);
+            if (index == NONE)
+            {
+                throw Celery::Except::OutOfRange();
+            }
+
+            return index;
+        }
+
+        /**
+         * @brief Keeps the function of a computed default, see `computed`.
+         */
+        template <typename T>
+        void provide(const size_t, const T &)
+        {
+        }
+
+        template <typename T>
+        void provide(const size_t slot, const computed<T> &def)
+        {
+            if (slot >= providers.size())
+            {
+                providers.resize(slots);
+            }
+
+            auto &provider = providers[slot] = std::make_unique<default_provider>();
+            provider->compute = [compute = def.compute]
+            {
+                value::storage stored;
+                value::wrap(stored, compute());
+                return stored;
+            };
+        }
+
+        [[nodiscard]] bool is_computed(const value &val) const
+        {
+            const size_t slot = val.get_slot();
+            return slot < providers.size() && providers[slot] != nullptr;
+        }
+
+        /**
+         * @brief Gets the default a value falls back to, computing it the first time if needed.
+         */
+        [[nodiscard]] const value::storage &default_of(const value &val) const
+        {
+            if (!is_computed(val))
+            {
+                return val.get_default();
+            }
+
+            // Apps may be shared between threads, e.g. through a parse cache
+            auto &provider = *providers[val.get_slot()];
+            std::call_once(provider.once, [&provider]
+            {
+                provider.result = provider.compute();
+            });
+
+            return provider.result;
+        }
+
+        /**
+         * @brief Computes a hash of everything that affects parse results.
+         *
+         * Two schemas with the same fingerprint assign the same slots to
+         * the same names and types, so results can be exchanged between them.
+         */
+        [[nodiscard]] uint64_t fingerprint() const
+        {
+            uint64_t result = 0;
+            for (size_t slot = 0; slot < slots; ++slot)
+            {
+                const auto &val = values[slot];
+                const auto &name = slot_names[slot];
+
+                fnv1a entry;
+                entry.update(command_slots.test(slot) ? 'c' : 'f');
+                entry.update(val.get_slot());
+                entry.update(val.get_type());
+                entry.update(name.Ptr(), name.Size());
+
+                // Choices travel as ids, which only mean the same thing over the same options
+                if (val.get_type() == value::CHOICE)
+                {
+                    const auto &options = *val.get<choice>().set();
+                    entry.update(options.size());
+                    for (size_t id = 0; id < options.size(); ++id)
+                    {
+                        entry.update(options[id].Size());
+                        entry.update(options[id].Ptr(), options[id].Size());
+                    }
+                }
+
+                result += entry.digest();
+            }
+
+            fnv1a hash;
+            hash.update(result);
+            hash.update(slots);
+            for (const auto &pos : positionals)
+            {
+                hash.update(pos.variadic);
+                hash.update(pos.name.Ptr(), pos.name.Size());
+            }
+
+            return hash.digest();
+        }
+    };
+}
@@ -0,0 +1,598 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/12/25.
+//
+
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "celery/except/base.h"
+#include "celery/string/external.h"
+#include "convert.h"
+#include "error.h"
+#include "schema.h"
+#include "traits.h"
+#include "value.h"
+
+namespace zelix::cli
+{
+    /**
+     * @brief Layout of the buffers produced by `args::serialize()`.
+     *
+     * Everything is addressed by offsets, so buffers can be copied,
+     * sent through pipes or mapped at any address:
+     *
+     * ```
+     * header
+     * uint32_t   slot_index[slot_count] ///< Slot -> entry, or NONE
+     * entry      entries[entry_count]
+     * list       lists[list_count]      ///< Positionals, then passthrough
+     * string_ref strings[string_count]
+     * char       pool[pool_size]        ///< Null-terminated strings
+     * ```
+     */
+    namespace blob
+    {
+        inline constexpr uint32_t MAGIC = 0x494c435a; ///< "ZCLI"
+        inline constexpr uint16_t VERSION = 1;
+        inline constexpr uint32_t NONE = UINT32_MAX;
+
+        class header
+        {
+        public:
+            uint32_t magic = MAGIC;
+            uint16_t version = VERSION;
+            uint16_t reserved = 0;
+            uint64_t fingerprint = 0; ///< Fingerprint of the schema
+            uint32_t cmd_slot = NONE; ///< Slot of the selected command
+            uint32_t slot_count = 0;
+            uint32_t entry_count = 0;
+            uint32_t list_count = 0;
+            uint32_t string_count = 0;
+            uint32_t pool_size = 0;
+        };
+
+        class entry
+        {
+        public:
+            uint32_t slot = 0;
+            uint8_t type = value::STRING; ///< A `value::type`
+            uint8_t raw = 0; ///< Whether the payload is an unconverted string
+            uint8_t source = 0; ///< An `args::source`
+            uint8_t command = 0; ///< Whether the entry is a command
+            uint64_t payload = 0; ///< The value, or a string index for strings
+        };
+
+        class list
+        {
+        public:
+            uint32_t first = 0; ///< Index of the first string
+            uint32_t count = 0;
+        };
+
+        class string_ref
+        {
+        public:
+            uint32_t offset = 0; ///< Offset in the pool
+            uint32_t size = 0;
+        };
+
+        /**
+         * @brief Builds a blob.
+         */
+        class writer
+        {
+            header head;
+            std::vector<uint32_t> slot_index;
+            std::vector<entry> entries;
+            std::vector<list> lists;
+            std::vector<string_ref> strings;
+            std::vector<char> pool;
+
+            template <typename T>
+            static void append(std::vector<unsigned char> &out, const T *data, const size_t count)
+            {
+                const auto bytes = reinterpret_cast<const unsigned char *>(data);
+                out.insert(out.end(), bytes, bytes + sizeof(T) * count);
+            }
+
+        public:
+            explicit writer(const uint64_t fingerprint, const size_t slots) :
+                slot_index(slots, NONE)
+            {
+                head.fingerprint = fingerprint;
+            }
+
+            uint32_t string(const Celery::Str::External &str)
+            {
+                strings.push_back(string_ref{static_cast<uint32_t>(pool.size()), static_cast<uint32_t>(str.Size())});
+                pool.insert(pool.end(), str.Ptr(), str.Ptr() + str.Size());
+                pool.push_back('\0');
+                return static_cast<uint32_t>(strings.size() - 1);
+            }
+
+            template <typename T>
+            void add(
+                const size_t slot,
+                const bool command,
+                const uint8_t source,
+                const T &val,
+                const bool raw = false
+            )
+            {
+                entry e;
+                e.slot = static_cast<uint32_t>(slot);
+                e.command = command;
+                e.source = source;
+                e.raw = raw;
+
+                if constexpr (std::is_same_v<T, Celery::Str::External>)
+                {
+                    e.type = value::STRING;
+                    e.payload = string(val);
+                }
+                else if constexpr (std::is_same_v<T, int>)
+                {
+                    e.type = value::INTEGER;
+                    memcpy(&e.payload, &val, sizeof(val));
+                }
+                else if constexpr (std::is_same_v<T, float>)
+                {
+                    e.type = value::FLOAT;
+                    memcpy(&e.payload, &val, sizeof(val));
+                }
+                else if constexpr (std::is_same_v<T, bool>)
+                {
+                    e.type = value::BOOL;
+                    e.payload = val;
+                }
+                else if constexpr (std::is_same_v<T, choice>)
+                {
+                    e.type = value::CHOICE;
+                    e.payload = val.id();
+                }
+                else
+                {
+                    static_assert(
+                        false,
+                        "Unsupported type for serialization"
+                    );
+                }
+
+                slot_index[slot] = static_cast<uint32_t>(entries.size());
+                entries.push_back(e);
+            }
+
+            /**
+             * @brief Adds a list of strings, e.g. the arguments of a positional.
+             */
+            template <typename View>
+            void add_list(const View &view)
+            {
+                list l;
+                l.first = static_cast<uint32_t>(strings.size());
+                l.count = static_cast<uint32_t>(view.size());
+
+                for (size_t i = 0; i < view.size(); ++i)
+                {
+                    string(view[i]);
+                }
+
+                lists.push_back(l);
+            }
+
+            void set_command(const size_t slot)
+            {
+                head.cmd_slot = static_cast<uint32_t>(slot);
+            }
+
+            [[nodiscard]] std::vector<unsigned char> finish()
+            {
+                // Keep the entries that follow 8-byte aligned
+                if (slot_index.size() % 2 != 0)
+                {
+                    slot_index.push_back(NONE);
+                }
+
+                head.slot_count = static_cast<uint32_t>(slot_index.size());
+                head.entry_count = static_cast<uint32_t>(entries.size());
+                head.list_count = static_cast<uint32_t>(lists.size());
+                head.string_count = static_cast<uint32_t>(strings.size());
+                head.pool_size = static_cast<uint32_t>(pool.size());
+
+                std::vector<unsigned char> out;
+                out.reserve(
+                    sizeof(header)
+                    + slot_index.size() * sizeof(uint32_t)
+                    + entries.size() * sizeof(entry)
+                    + lists.size() * sizeof(list)
+                    + strings.size() * sizeof(string_ref)
+                    + pool.size()
+                );
+
+                append(out, &head, 1);
+                append(out, slot_index.data(), slot_index.size());
+                append(out, entries.data(), entries.size());
+                append(out, lists.data(), lists.size());
+                append(out, strings.data(), strings.size());
+                append(out, pool.data(), pool.size());
+                return out;
+            }
+        };
+    }
+
+    /**
+     * @brief A list of strings stored in a serialized blob.
+     */
+    class packed_list
+    {
+        const blob::string_ref *refs = nullptr;
+        const char *pool = nullptr;
+        size_t count = 0;
+
+    public:
+        explicit packed_list() = default;
+
+        explicit packed_list(
+            const blob::string_ref *refs,
+            const char *pool,
+            const size_t count
+        ) :
+            refs(refs), pool(pool), count(count)
+        {}
+
+        [[nodiscard]] size_t size() const
+        {
+            return count;
+        }
+
+        [[nodiscard]] bool empty() const
+        {
+            return count == 0;
+        }
+
+        Celery::Str::External operator[](const size_t i) const
+        {
+            blob::string_ref ref;
+            memcpy(&ref, refs + i, sizeof(ref));
+            return Celery::Str::External(pool + ref.offset, ref.size);
+        }
+
+        template <typename T>
+        bool get(const size_t i, T &out) const
+        {
+            if (i >= count)
+            {
+                throw Celery::Except::OutOfRange();
+            }
+
+            return convert<T>((*this)[i], out);
+        }
+    };
+
+    /**
+     * @brief Read-only, zero-copy view over a buffer made by `args::serialize()`.
+     *
+     * Lets another process or thread read the result of a parse without
+     * re-parsing argv. The view reads straight from the buffer, which
+     * must outlive it (and must be suitably aligned, e.g. mapped memory
+     * or memory from `malloc()`).
+     */
+    class args_view
+    {
+        const schema *schema_ = nullptr;
+        const unsigned char *data = nullptr;
+
+        blob::header head;
+        const uint32_t *slot_index = nullptr;
+        const blob::entry *entries = nullptr;
+        const blob::list *lists = nullptr;
+        const blob::string_ref *strings = nullptr;
+        const char *pool = nullptr;
+
+        Celery::Str::External cmd;
+
+        [[nodiscard]] const blob::entry *find(const size_t slot) const
+        {
+            if (slot >= head.slot_count || slot_index[slot] == blob::NONE)
+            {
+                return nullptr;
+            }
+
+            return entries + slot_index[slot];
+        }
+
+        [[nodiscard]] packed_list list_at(const size_t i) const
+        {
+            if (i >= head.list_count)
+            {
+                return packed_list();
+            }
+
+            return packed_list(strings + lists[i].first, pool, lists[i].count);
+        }
+
+        template <typename T>
+        T val(const blob::entry *e, const value &def) const
+        {
+            const auto fallback = [this, &def]
+            {
+                return def.get<T>(schema_->default_of(def));
+            };
+
+            if (e == nullptr)
+            {
+                return fallback();
+            }
+
+            if (e->raw || e->type == value::STRING)
+            {
+                const auto str = packed_list(strings + e->payload, pool, 1)[0];
+                if constexpr (std::is_same_v<T, Celery::Str::External>)
+                {
+                    return str;
+                }
+                else
+                {
+                    T out = def.get<T>();
+                    if (!value_traits<T>::parse(str, out))
+                    {
+                        global_error.error_type = error::TYPE_MISMATCH;
+                        return fallback();
+                    }
+
+                    return out;
+                }
+            }
+
+            if constexpr (std::is_same_v<T, int> || std::is_same_v<T, float>)
+            {
+                if (e->type == (std::is_same_v<T, int> ? value::INTEGER : value::FLOAT))
+                {
+                    T out;
+                    memcpy(&out, &e->payload, sizeof(out));
+                    return out;
+                }
+            }
+            else if constexpr (std::is_same_v<T, bool>)
+            {
+                if (e->type == value::BOOL)
+                {
+                    return e->payload != 0;
+                }
+            }
+            else if constexpr (std::is_same_v<T, choice>)
+            {
+                const auto def_choice = def.get<choice>();
+                if (e->type == value::CHOICE && e->payload < def_choice.set()->size())
+                {
+                    return choice(*def_choice.set(), e->payload);
+                }
+            }
+
+            return fallback();
+        }
+
+        /**
+         * @brief Checks every index and offset of the buffer against its tables.
+         *
+         * Done once when the view is created, so accessors can trust them.
+         */
+        void validate() const
+        {
+            for (uint32_t slot = 0; slot < head.slot_count; ++slot)
+            {
+                if (slot_index[slot] != blob::NONE && slot_index[slot] >= head.entry_count)
+                {
+                    throw Celery::Except::Exception("Slot index out of range");
+                }
+            }
+
+            for (uint32_t i = 0; i < head.entry_count; ++i)
+            {
+                const auto &e = entries[i];
+                if (e.type > value::CUSTOM)
+                {
+                    throw Celery::Except::Exception("Invalid value type");
+                }
+
+                if ((e.raw || e.type == value::STRING) && e.payload >= head.string_count)
+                {
+                    throw Celery::Except::Exception("String index out of range");
+                }
+            }
+
+            for (uint32_t i = 0; i < head.list_count; ++i)
+            {
+                if (static_cast<uint64_t>(lists[i].first) + lists[i].count > head.string_count)
+                {
+                    throw Celery::Except::Exception("List out of range");
+                }
+            }
+
+            for (uint32_t i = 0; i < head.string_count; ++i)
+            {
+                // Strings are handed out as C strings too, so the terminator must be there
+                const uint64_t end = static_cast<uint64_t>(strings[i].offset) + strings[i].size;
+                if (end >= head.pool_size || pool[end] != '\0')
+                {
+                    throw Celery::Except::Exception("String out of range");
+                }
+            }
+        }
+
+    public:
+        explicit args_view() = default;
+
+        /**
+         * @brief Creates a view over a serialized buffer.
+         *
+         * Throws if the buffer is malformed (every index and offset in it
+         * is checked here, once) or was produced by an app with a
+         * different schema. The flags of the selected command are
+         * registered first if they weren't already, see `schema::load()`.
+         *
+         * @param schema_ The schema of the reading app.
+         * @param bytes The buffer.
+         * @param size The size of the buffer.
+         */
+        static args_view from_bytes(
+            schema &schema_,
+            const void *bytes,
+            const size_t size
+        )
+        {
+            args_view view;
+            view.schema_ = &schema_;
+            view.data = static_cast<const unsigned char *>(bytes);
+
+            if (size < sizeof(blob::header))
+            {
+                throw Celery::Except::Exception("Buffer is too small");
+            }
+
+            if (reinterpret_cast<uintptr_t>(bytes) % alignof(blob::entry) != 0)
+            {
+                throw Celery::Except::Exception("Buffer is misaligned");
+            }
+
+            memcpy(&view.head, view.data, sizeof(blob::header));
+            const auto &head = view.head;
+            if (head.magic != blob::MAGIC || head.version != blob::VERSION)
+            {
+                throw Celery::Except::Exception("Not a serialized argument buffer");
+            }
+
+            // Command slots are handed out at registration, so the header
+            // tells which registrar the producing app had run
+            if (
+                head.cmd_slot < schema_.slots
+                && schema_.command_slots.test(head.cmd_slot)
+                && !schema_.registrars.empty()
+            )
+            {
+                const auto command = schema_.slot_names[head.cmd_slot];
+                schema_.load(command);
+            }
+
+            if (head.fingerprint != schema_.fingerprint())
+            {
+                throw Celery::Except::Exception("Schema fingerprint mismatch");
+            }
+
+            const size_t expected = sizeof(blob::header)
+                + static_cast<size_t>(head.slot_count) * sizeof(uint32_t)
+                + static_cast<size_t>(head.entry_count) * sizeof(blob::entry)
+                + static_cast<size_t>(head.list_count) * sizeof(blob::list)
+                + static_cast<size_t>(head.string_count) * sizeof(blob::string_ref)
+                + head.pool_size;
+
+            if (size < expected)
+            {
+                throw Celery::Except::Exception("Buffer is truncated");
+            }
+
+            const unsigned char *cursor = view.data + sizeof(blob::header);
+            view.slot_index = reinterpret_cast<const uint32_t *>(cursor);
+            cursor += head.slot_count * sizeof(uint32_t);
+            view.entries = reinterpret_cast<const blob::entry *>(cursor);
+            cursor += head.entry_count * sizeof(blob::entry);
+            view.lists = reinterpret_cast<const blob::list *>(cursor);
+            cursor += head.list_count * sizeof(blob::list);
+            view.strings = reinterpret_cast<const blob::string_ref *>(cursor);
+            cursor += head.string_count * sizeof(blob::string_ref);
+            view.pool = reinterpret_cast<const char *>(cursor);
+            view.validate();
+
+            // Resolve the command name once
+            if (head.cmd_slot != blob::NONE)
+            {
+                if (head.cmd_slot >= schema_.slots || !schema_.command_slots.test(head.cmd_slot))
+                {
+                    throw Celery::Except::Exception("Unknown command slot");
+                }
+
+                view.cmd = schema_.slot_names[head.cmd_slot];
+            }
+
+            return view;
+        }
+
+        template <typename T>
+        T flag(const Celery::Str::External &name) const
+        {
+            const auto &def = schema_->flag(name);
+            return val<T>(find(def.get_slot()), def);
+        }
+
+        template <typename T>
+        T flag(const char *name) const
+        {
+            return flag<T>(Celery::Str::External(name));
+        }
+
+        template <typename T>
+        T command(const Celery::Str::External &name) const
+        {
+            const auto &def = schema_->command(name);
+            return val<T>(find(def.get_slot()), def);
+        }
+
+        template <typename T>
+        T command(const char *name) const
+        {
+            return command<T>(Celery::Str::External(name));
+        }
+
+        [[nodiscard]] packed_list positional(const Celery::Str::External &name) const
+        {
+            return list_at(schema_->positional(name));
+        }
+
+        [[nodiscard]] packed_list positional(const char *name) const
+        {
+            return positional(Celery::Str::External(name));
+        }
+
+        [[nodiscard]] packed_list passthrough() const
+        {
+            return list_at(schema_->positionals.size());
+        }
+
+        /**
+         * @brief Gets the selected command.
+         *
+         * Like `args::get_cmd()`, the pointer is the one the command
+         * was registered with, so it can be compared directly.
+         */
+        [[nodiscard]] const Celery::Str::External &get_cmd() const
+        {
+            return cmd;
+        }
+    };
+}
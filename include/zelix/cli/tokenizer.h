@@ -0,0 +1,334 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/7/25.
+//
+
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include "error.h"
+
+#if defined(__SSE2__)
+#   include <emmintrin.h>
+#endif
+
+namespace zelix::cli
+{
+    /**
+     * @brief In-place, shell-style command line splitter.
+     *
+     * Splits a raw command line into arguments directly inside the
+     * caller's buffer, following the usual shell rules:
+     * - Arguments are separated by spaces, tabs or newlines
+     * - Single quotes preserve everything up to the next single quote
+     * - Double quotes preserve everything up to the next double quote,
+     *   except for `\"` and `\\`
+     * - Outside quotes, a backslash escapes the next character, and a
+     *   backslash followed by a newline is a line continuation
+     *
+     * Quotes and escapes only ever shrink an argument, so arguments are
+     * compacted and null-terminated in place, and the resulting argv can
+     * be handed to `app::parse()` without copying anything.
+     */
+    class tokenizer
+    {
+        static bool is_space(const char c)
+        {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+        }
+
+        static bool is_special(const char c)
+        {
+            return is_space(c) || c == '\'' || c == '"' || c == '\\';
+        }
+
+        /**
+         * @brief Finds the first whitespace, quote or backslash.
+         * @return The index of the byte, or `n` if there is none.
+         */
+        static size_t find_special(const char *ptr, const size_t n)
+        {
+            size_t i = 0;
+
+#if defined(__SSE2__)
+            const __m128i space = _mm_set1_epi8(' ');
+            const __m128i tab = _mm_set1_epi8('\t');
+            const __m128i newline = _mm_set1_epi8('\n');
+            const __m128i carriage = _mm_set1_epi8('\r');
+            const __m128i single_quote = _mm_set1_epi8('\'');
+            const __m128i double_quote = _mm_set1_epi8('"');
+            const __m128i backslash = _mm_set1_epi8('\\');
+
+            for (; i + 16 <= n; i += 16)
+            {
+                const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr + i));
+                const __m128i hits = _mm_or_si128(
+                    _mm_or_si128(
+                        _mm_or_si128(_mm_cmpeq_epi8(chunk, space), _mm_cmpeq_epi8(chunk, tab)),
+                        _mm_or_si128(_mm_cmpeq_epi8(chunk, newline), _mm_cmpeq_epi8(chunk, carriage))
+                    ),
+                    _mm_or_si128(
+                        _mm_or_si128(_mm_cmpeq_epi8(chunk, single_quote), _mm_cmpeq_epi8(chunk, double_quote)),
+                        _mm_cmpeq_epi8(chunk, backslash)
+                    )
+                );
+
+                if (const int mask = _mm_movemask_epi8(hits); mask != 0)
+                {
+                    return i + __builtin_ctz(mask);
+                }
+            }
+#endif
+
+            for (; i < n; ++i)
+            {
+                if (is_special(ptr[i]))
+                {
+                    return i;
+                }
+            }
+
+            return n;
+        }
+
+        /**
+         * @brief Finds the first double quote or backslash.
+         * @return The index of the byte, or `n` if there is none.
+         */
+        static size_t find_double_quote(const char *ptr, const size_t n)
+        {
+            size_t i = 0;
+
+#if defined(__SSE2__)
+            const __m128i double_quote = _mm_set1_epi8('"');
+            const __m128i backslash = _mm_set1_epi8('\\');
+
+            for (; i + 16 <= n; i += 16)
+            {
+                const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr + i));
+                const __m128i hits = _mm_or_si128(
+                    _mm_cmpeq_epi8(chunk, double_quote),
+                    _mm_cmpeq_epi8(chunk, backslash)
+                );
+
+                if (const int mask = _mm_movemask_epi8(hits); mask != 0)
+                {
+                    return i + __builtin_ctz(mask);
+                }
+            }
+#endif
+
+            for (; i < n; ++i)
+            {
+                if (ptr[i] == '"' || ptr[i] == '\\')
+                {
+                    return i;
+                }
+            }
+
+            return n;
+        }
+
+        /**
+         * @brief Moves a run of ordinary bytes to the write position.
+         */
+        static void shift(char *buf, size_t &write, size_t &read, const size_t n)
+        {
+            if (write != read)
+            {
+                memmove(buf + write, buf + read, n);
+            }
+
+            write += n;
+            read += n;
+        }
+
+    public:
+        /**
+         * @brief Splits a command line in place.
+         *
+         * Usage:
+         * ```c++
+         * const char *argv[256];
+         * size_t lens[256];
+         * const int argc = cli::tokenizer::split(line, len, argv, lens, 256);
+         * if (argc < 0) { ... }
+         *
+         * cli::args args = app.parse(argc, argv, lens);
+         * ```
+         *
+         * @param buf The command line. It is modified in place and must
+         *            have room for `len + 1` bytes (the last argument is
+         *            null-terminated at `buf[len]` at most).
+         * @param len The length of the command line.
+         * @param argv Where to store the arguments.
+         * @param lens Where to store the length of each argument, may be null.
+         * @param capacity The capacity of `argv` and `lens`. If there is room
+         *                 left, `argv` is null-terminated.
+         * @return The number of arguments, or -1 on error, in which case the
+         *         global error is set to `UNTERMINATED_QUOTE`, `UNTERMINATED_ESCAPE`
+         *         (a lone backslash at the very end) or `TOO_MANY_ARGUMENTS`.
+         */
+        static int split(
+            char *buf,
+            const size_t len,
+            const char **argv,
+            size_t *lens,
+            const int capacity
+        )
+        {
+            size_t read = 0;
+            int argc = 0;
+
+            while (true)
+            {
+                // Skip separators
+                while (read < len && is_space(buf[read]))
+                {
+                    ++read;
+                }
+
+                if (read >= len)
+                {
+                    break;
+                }
+
+                if (argc == capacity)
+                {
+                    global_error.error_type = error::TOO_MANY_ARGUMENTS;
+                    global_error.argv_pos = 0;
+                    return -1;
+                }
+
+                const size_t start = read;
+                size_t write = read;
+                while (read < len)
+                {
+                    // Copy everything up to the next interesting byte
+                    shift(buf, write, read, find_special(buf + read, len - read));
+                    if (read >= len || is_space(buf[read]))
+                    {
+                        break;
+                    }
+
+                    const char c = buf[read++];
+                    if (c == '\\')
+                    {
+                        // Like an unterminated quote, there is nothing to escape
+                        if (read >= len)
+                        {
+                            global_error.error_type = error::UNTERMINATED_ESCAPE;
+                            global_error.argv_pos = 0;
+                            global_error.offset = read - 1;
+                            return -1;
+                        }
+
+                        if (buf[read] != '\n')
+                        {
+                            buf[write++] = buf[read];
+                        }
+
+                        ++read;
+                        continue;
+                    }
+
+                    if (c == '\'')
+                    {
+                        const auto quote = static_cast<const char *>(
+                            memchr(buf + read, '\'', len - read)
+                        );
+
+                        if (quote == nullptr)
+                        {
+                            global_error.error_type = error::UNTERMINATED_QUOTE;
+                            global_error.argv_pos = 0;
+                            return -1;
+                        }
+
+                        shift(buf, write, read, quote - (buf + read));
+                        ++read; // Skip the closing quote
+                        continue;
+                    }
+
+                    // Double quotes
+                    while (true)
+                    {
+                        shift(buf, write, read, find_double_quote(buf + read, len - read));
+                        if (read >= len)
+                        {
+                            global_error.error_type = error::UNTERMINATED_QUOTE;
+                            global_error.argv_pos = 0;
+                            return -1;
+                        }
+
+                        if (buf[read] == '"')
+                        {
+                            ++read; // Skip the closing quote
+                            break;
+                        }
+
+                        // Only a few characters can be escaped inside double quotes
+                        const char next = read + 1 < len ? buf[read + 1] : '\0';
+                        if (next == '"' || next == '\\')
+                        {
+                            buf[write++] = next;
+                            read += 2;
+                        }
+                        else if (next == '\n')
+                        {
+                            read += 2;
+                        }
+                        else
+                        {
+                            buf[write++] = buf[read++];
+                        }
+                    }
+                }
+
+                argv[argc] = buf + start;
+                if (lens != nullptr)
+                {
+                    lens[argc] = write - start;
+                }
+
+                // The separator (if any) has been consumed at this point,
+                // so it is safe to overwrite it with the terminator
+                buf[write] = '\0';
+                ++read;
+                ++argc;
+            }
+
+            // Keep the vector null-terminated like a real argv
+            if (argc < capacity)
+            {
+                argv[argc] = nullptr;
+            }
+
+            return argc;
+        }
+    };
+}
@@ -0,0 +1,258 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/18/25.
+//
+
+#pragma once
+#include <cstring>
+#include <string>
+#include "celery/string/external.h"
+#include "celery/string/string.h"
+#include "choice.h"
+#include "convert.h"
+#include "value.h"
+
+namespace zelix::cli
+{
+    /*
+     * Every type a command or flag can hold has a `value_traits`
+     * specialization with:
+     *
+     *   static constexpr value::type kind;
+     *   static bool parse(const Celery::Str::External &text, T &out);
+     *   static void describe(const T &def, Celery::Str::String &out);
+     *   static void format(const T &val, Celery::Str::String &out);
+     *
+     * `parse()` receives `out` holding the default, `describe()` writes
+     * the type name shown in the help message and `format()` writes a
+     * value. User types use `value::CUSTOM` as their kind, e.g.:
+     *
+     *   template <>
+     *   struct zelix::cli::value_traits<duration>
+     *   {
+     *       static constexpr auto kind = zelix::cli::value::CUSTOM;
+     *       static bool parse(const Celery::Str::External &text, duration &out);
+     *       static void describe(const duration &, Celery::Str::String &out);
+     *       static void format(const duration &val, Celery::Str::String &out);
+     *   };
+     */
+
+    template <>
+    struct value_traits<Celery::Str::External>
+    {
+        static constexpr auto kind = value::STRING;
+
+        static bool parse(const Celery::Str::External &text, Celery::Str::External &out)
+        {
+            return convert(text, out);
+        }
+
+        static void describe(const Celery::Str::External &, Celery::Str::String &out)
+        {
+            out.Write("str", 3);
+        }
+
+        static void format(const Celery::Str::External &val, Celery::Str::String &out)
+        {
+            out.Write(val.Ptr(), val.Size());
+        }
+    };
+
+    template <>
+    struct value_traits<const char *>
+    {
+        static constexpr auto kind = value::STRING;
+
+        static bool parse(const Celery::Str::External &text, const char *&out)
+        {
+            return convert(text, out);
+        }
+
+        static void describe(const char *, Celery::Str::String &out)
+        {
+            out.Write("str", 3);
+        }
+
+        static void format(const char *val, Celery::Str::String &out)
+        {
+            out.Write(val, strlen(val));
+        }
+    };
+
+    template <>
+    struct value_traits<int>
+    {
+        static constexpr auto kind = value::INTEGER;
+
+        static bool parse(const Celery::Str::External &text, int &out)
+        {
+            return convert(text, out);
+        }
+
+        static void describe(const int, Celery::Str::String &out)
+        {
+            out.Write("int", 3);
+        }
+
+        static void format(const int val, Celery::Str::String &out)
+        {
+            const std::string int_str = std::to_string(val);
+            out.Write(int_str.c_str(), int_str.size());
+        }
+    };
+
+    template <>
+    struct value_traits<float>
+    {
+        static constexpr auto kind = value::FLOAT;
+
+        static bool parse(const Celery::Str::External &text, float &out)
+        {
+            return convert(text, out);
+        }
+
+        static void describe(const float, Celery::Str::String &out)
+        {
+            out.Write("float", 5);
+        }
+
+        static void format(const float val, Celery::Str::String &out)
+        {
+            const std::string float_str = std::to_string(val);
+            out.Write(float_str.c_str(), float_str.size());
+        }
+    };
+
+    template <>
+    struct value_traits<bool>
+    {
+        static constexpr auto kind = value::BOOL;
+
+        static bool parse(const Celery::Str::External &text, bool &out)
+        {
+            return convert(text, out);
+        }
+
+        static void describe(const bool, Celery::Str::String &out)
+        {
+            out.Write("bool", 4);
+        }
+
+        static void format(const bool val, Celery::Str::String &out)
+        {
+            if (val)
+            {
+                out.Write("true", 4);
+            }
+            else
+            {
+                out.Write("false", 5);
+            }
+        }
+    };
+
+    template <>
+    struct value_traits<choice>
+    {
+        static constexpr auto kind = value::CHOICE;
+
+        static bool parse(const Celery::Str::External &text, choice &out)
+        {
+            return convert(text, out);
+        }
+
+        static void describe(const choice &def, Celery::Str::String &out)
+        {
+            const auto &set = *def.set();
+            for (size_t i = 0; i < set.size(); ++i)
+            {
+                if (i != 0)
+                {
+                    out.Write('|');
+                }
+
+                out.Write(set[i].Ptr(), set[i].Size());
+            }
+        }
+
+        static void format(const choice &val, Celery::Str::String &out)
+        {
+            out.Write(val.str().Ptr(), val.str().Size());
+        }
+    };
+
+    /**
+     * @brief `value_traits`, erased so values can be handled without knowing their type.
+     */
+    class value_ops
+    {
+    public:
+        /// Converts `text` into `out`, which holds the default on entry
+        bool (*parse)(const Celery::Str::External &text, value::storage &out);
+
+        /// Writes the type name shown in the help message
+        void (*describe)(const value::storage &def, Celery::Str::String &out);
+
+        /// Writes a value
+        void (*format)(const value::storage &val, Celery::Str::String &out);
+    };
+
+    template <typename T>
+    const value_ops *ops_of()
+    {
+        // const char * values are stored as slices
+        using stored = std::conditional_t<
+            std::is_same_v<T, const char *>,
+            Celery::Str::External,
+            T
+        >;
+
+        static constexpr value_ops ops = {
+            [](const Celery::Str::External &text, value::storage &out)
+            {
+                auto result = value::unwrap<stored>(out);
+                if (!value_traits<stored>::parse(text, result))
+                {
+                    return false;
+                }
+
+                value::wrap(out, result);
+                return true;
+            },
+            [](const value::storage &def, Celery::Str::String &out)
+            {
+                value_traits<stored>::describe(value::unwrap<stored>(def), out);
+            },
+            [](const value::storage &val, Celery::Str::String &out)
+            {
+                value_traits<stored>::format(value::unwrap<stored>(val), out);
+            }
+        };
+
+        return &ops;
+    }
+}
@@ -0,0 +1,206 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/22/25.
+//
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__SSE2__)
+#   include <emmintrin.h>
+#endif
+
+namespace zelix::cli
+{
+    /**
+     * @brief UTF-8 validation for untrusted values.
+     *
+     * Runs of ASCII are skipped 16 bytes at a time, and only
+     * multibyte sequences are decoded one by one, so mostly-ASCII
+     * values cost little more than a `memchr()`.
+     */
+    class utf8
+    {
+        static bool is_control(const unsigned char c)
+        {
+            return c < 0x20 || c == 0x7F;
+        }
+
+        /**
+         * @brief Finds the first non-ASCII byte, or control character if `control` is set.
+         * @return The index of the byte, or `n` if there is none.
+         */
+        static size_t find_special(const char *ptr, const size_t n, const bool control)
+        {
+            size_t i = 0;
+
+#if defined(__SSE2__)
+            const __m128i space = _mm_set1_epi8(0x20);
+            const __m128i del = _mm_set1_epi8(0x7F);
+
+            for (; i + 16 <= n; i += 16)
+            {
+                const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr + i));
+
+                // Non-ASCII bytes have their sign bit set
+                int mask = _mm_movemask_epi8(chunk);
+                if (control)
+                {
+                    // Signed, so this also catches non-ASCII bytes
+                    const __m128i hits = _mm_or_si128(
+                        _mm_cmplt_epi8(chunk, space),
+                        _mm_cmpeq_epi8(chunk, del)
+                    );
+
+                    mask |= _mm_movemask_epi8(hits);
+                }
+
+                if (mask != 0)
+                {
+                    return i + __builtin_ctz(mask);
+                }
+            }
+#endif
+
+            for (; i < n; ++i)
+            {
+                const auto c = static_cast<unsigned char>(ptr[i]);
+                if (c >= 0x80 || (control && is_control(c)))
+                {
+                    return i;
+                }
+            }
+
+            return n;
+        }
+
+        /**
+         * @brief Decodes the character starting at `i`.
+         * @return The index right after it, or `NONE` if it is invalid.
+         */
+        static size_t decode(const char *ptr, const size_t n, const size_t i, const bool control)
+        {
+            const auto *bytes = reinterpret_cast<const unsigned char *>(ptr);
+            const unsigned char lead = bytes[i];
+            if (lead < 0x80)
+            {
+                return control && is_control(lead) ? NONE : i + 1;
+            }
+
+            size_t length;
+            unsigned char low = 0x80; ///< Bounds of the second byte, which rule
+            unsigned char high = 0xBF; ///< out overlongs, surrogates and > U+10FFFF
+
+            if (lead >= 0xC2 && lead <= 0xDF)
+            {
+                length = 2;
+
+                // C1 control characters (U+0080 to U+009F)
+                if (control && lead == 0xC2)
+                {
+                    low = 0xA0;
+                }
+            }
+            else if (lead >= 0xE0 && lead <= 0xEF)
+            {
+                length = 3;
+                if (lead == 0xE0)
+                {
+                    low = 0xA0;
+                }
+                else if (lead == 0xED)
+                {
+                    high = 0x9F;
+                }
+            }
+            else if (lead >= 0xF0 && lead <= 0xF4)
+            {
+                length = 4;
+                if (lead == 0xF0)
+                {
+                    low = 0x90;
+                }
+                else if (lead == 0xF4)
+                {
+                    high = 0x8F;
+                }
+            }
+            else
+            {
+                return NONE;
+            }
+
+            if (i + length > n || bytes[i + 1] < low || bytes[i + 1] > high)
+            {
+                return NONE;
+            }
+
+            for (size_t j = 2; j < length; ++j)
+            {
+                if ((bytes[i + j] & 0xC0) != 0x80)
+                {
+                    return NONE;
+                }
+            }
+
+            return i + length;
+        }
+
+    public:
+        static constexpr size_t NONE = SIZE_MAX;
+
+        /**
+         * @brief Finds the first invalid character.
+         * @param ptr The text.
+         * @param n The size of the text.
+         * @param control Whether control characters (C0, DEL and C1) are invalid too.
+         * @return The offset of the first byte of the character, or `NONE`
+         *         if the whole text is valid.
+         */
+        static size_t validate(const char *ptr, const size_t n, const bool control = false)
+        {
+            size_t i = 0;
+            while (true)
+            {
+                i += find_special(ptr + i, n - i, control);
+                if (i == n)
+                {
+                    return NONE;
+                }
+
+                const size_t next = decode(ptr, n, i, control);
+                if (next == NONE)
+                {
+                    return i;
+                }
+
+                i = next;
+            }
+        }
+    };
+}
@@ -28,10 +28,95 @@
 //
 
 #pragma once
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <variant>
 #include "celery/string/external.h"
+#include "choice.h"
 
 namespace zelix::cli
 {
+    /**
+     * @brief Customization point for the types a command or flag can hold.
+     *
+     * Specializations provide `kind`, `parse()`, `describe()` and
+     * `format()`; see `traits.h` for the built-in ones.
+     */
+    template <typename T>
+    struct value_traits;
+
+    class value_ops;
+
+    template <typename T>
+    const value_ops *ops_of();
+
+    /**
+     * @brief Inline storage for a value of a user-defined type.
+     *
+     * User types must be trivially copyable and fit in 16 bytes, so
+     * they can be stored and parsed without allocating.
+     */
+    class value_storage
+    {
+        alignas(8) unsigned char bytes[16] = {};
+
+    public:
+        template <typename T>
+        static constexpr bool fits = std::is_trivially_copyable_v<T>
+            && std::is_default_constructible_v<T>
+            && sizeof(T) <= sizeof(bytes)
+            && alignof(T) <= 8;
+
+        template <typename T>
+        void put(const T &val)
+        {
+            static_assert(fits<T>, "Custom value types must be trivially copyable and at most 16 bytes");
+            memcpy(bytes, &val, sizeof(T));
+        }
+
+        template <typename T>
+        T get() const
+        {
+            static_assert(fits<T>, "Custom value types must be trivially copyable and at most 16 bytes");
+
+            T out;
+            memcpy(&out, bytes, sizeof(T));
+            return out;
+        }
+    };
+
+    /**
+     * @brief A default value computed the first time it is needed.
+     *
+     * Registered like any other default, e.g. for defaults that are
+     * expensive to find out and usually overridden:
+     *
+     * ```c++
+     * app.flag("jobs", "j", "parallel jobs", cli::computed([] { return cpu_quota(); }));
+     * ```
+     *
+     * The function runs at most once per app, and only when the value
+     * is read without having been given (or when the help message
+     * shows it). Strings it returns must outlive the app. Conversions
+     * of given values start from a blank value instead, which only
+     * matters for user types that fill in part of their value.
+     */
+    template <typename T>
+    class computed
+    {
+    public:
+        std::function<T()> compute;
+
+        explicit computed(std::function<T()> compute) :
+            compute(std::move(compute))
+        {}
+    };
+
+    template <typename F>
+    computed(F) -> computed<std::invoke_result_t<F>>;
+
     class value
     {
     public:
@@ -40,22 +125,87 @@ namespace zelix::cli
             STRING,
             INTEGER,
             FLOAT,
-            BOOL
+            BOOL,
+            CHOICE,
+            CUSTOM
         };
 
+        /**
+         * @brief A value of any registered type. Alternatives follow `type`.
+         */
+        using storage = std::variant<
+            Celery::Str::External,
+            int,
+            float,
+            bool,
+            choice,
+            value_storage
+        >;
+
+        /**
+         * @brief Extracts a typed value out of its storage.
+         */
+        template <typename T>
+        static T unwrap(const storage &stored)
+        {
+            if constexpr (std::is_same_v<T, const char *>)
+            {
+                return std::get<Celery::Str::External>(stored).Ptr();
+            }
+            else if constexpr (value_traits<T>::kind == CUSTOM)
+            {
+                return std::get<value_storage>(stored).get<T>();
+            }
+            else
+            {
+                return std::get<T>(stored);
+            }
+        }
+
+        /**
+         * @brief Puts a typed value into its storage.
+         */
+        template <typename T>
+        static void wrap(storage &stored, const T &val)
+        {
+            if constexpr (std::is_same_v<T, const char *>)
+            {
+                stored = Celery::Str::External(val);
+            }
+            else if constexpr (value_traits<T>::kind == CUSTOM)
+            {
+                value_storage raw;
+                raw.put(val);
+                stored = raw;
+            }
+            else
+            {
+                stored = val;
+            }
+        }
+
     private:
-        type value_type = STRING; ///< Type of the value
+        size_t slot = 0; ///< Unique id of the command or flag within its app
         Celery::Str::External description; ///< Description of the value
+        const value_ops *ops = nullptr; ///< Type-erased traits of the value
+        storage default_value; ///< Default value, blank for computed ones; its alternative gives the type
 
-        // Default values
-        Celery::Str::External default_str;
-        int default_int = 0;
-        float default_float = 0.0f;
-        bool default_bool = false;
+        template <typename T>
+        static T placeholder()
+        {
+            if constexpr (std::is_same_v<T, const char *>)
+            {
+                return "";
+            }
+            else
+            {
+                return T();
+            }
+        }
 
     public:
         explicit value() :
-            description("", 1), default_str("", 1)
+            description("", 1), default_value(Celery::Str::External("", 1))
         {}
 
         /**
@@ -68,47 +218,51 @@ namespace zelix::cli
             const T default_value,
             const Celery::Str::External &description
         ) :
-            description(description), default_str("", 1)
+            description(description), ops(ops_of<T>())
         {
             if (description.Size() == 0)
             {
                 throw Celery::Except::OutOfRange();
             }
 
-            if constexpr (std::is_same_v<T, Celery::Str::External>)
-            {
-                value_type = STRING;
-                default_str = default_value;
-            }
-            else if constexpr (std::is_same_v<T, int>)
-            {
-                value_type = INTEGER;
-                default_int = default_value;
-            }
-            else if constexpr (std::is_same_v<T, float>)
-            {
-                value_type = FLOAT;
-                default_float = default_value;
-            }
-            else if constexpr (std::is_same_v<T, bool>)
-            {
-                value_type = BOOL;
-                default_bool = default_value;
-            }
-            else if constexpr (std::is_same_v<T, const char *>)
-            {
-                value_type = STRING;
-                default_str = Celery::Str::External(default_value);
-            }
-            else
-            {
-                throw Celery::Except::OutOfRange();
-            }
+            wrap(this->default_value, default_value);
+        }
+
+        /**
+         * @brief Constructs a value whose default is computed on first use.
+         *
+         * Only the type is taken from `default_value`; the function is
+         * kept by the schema, see `schema::provide()`.
+         *
+         * @param default_value Computes the default value.
+         * @param description The description of the value.
+         */
+        template <typename T>
+        explicit value(
+            [[maybe_unused]] const computed<T> &default_value,
+            const Celery::Str::External &description
+        ) :
+            value(placeholder<T>(), description)
+        {
+            static_assert(
+                !std::is_same_v<T, choice>,
+                "Choices need their set at registration, give them a fixed default"
+            );
         }
 
         [[nodiscard]] type get_type() const
         {
-            return value_type;
+            return static_cast<type>(default_value.index());
+        }
+
+        [[nodiscard]] size_t get_slot() const
+        {
+            return slot;
+        }
+
+        void set_slot(const size_t id)
+        {
+            slot = id;
         }
 
         [[nodiscard]] const Celery::Str::External &get_description()
@@ -117,29 +271,52 @@ namespace zelix::cli
             return description;
         }
 
+        [[nodiscard]] const value_ops &get_ops() const
+        {
+            return *ops;
+        }
+
+        /**
+         * @brief Gets the default value, or a blank one if it is computed.
+         *
+         * Conversions start from it. Use `schema::default_of()` for the
+         * default a value actually falls back to.
+         */
+        [[nodiscard]] const storage &get_default() const
+        {
+            return default_value;
+        }
+
+        /**
+         * @brief Gets a stored value of this value's type.
+         * @param stored The value, e.g. from `schema::default_of()`.
+         */
         template <typename T>
-        T get()
+        T get(const storage &stored)
         const {
-            if constexpr (std::is_same_v<T, Celery::Str::External>)
+            if constexpr (std::is_same_v<T, const char *>)
             {
-                return default_str;
-            }
-            else if constexpr (std::is_same_v<T, int>)
-            {
-                return default_int;
-            }
-            else if constexpr (std::is_same_v<T, float>)
-            {
-                return default_float;
-            }
-            else if constexpr (std::is_same_v<T, bool>)
-            {
-                return default_bool;
+                return get<Celery::Str::External>(stored).Ptr();
             }
             else
             {
-                throw Celery::Except::OutOfRange();
+                // Different custom types share a kind, but not their traits
+                if (
+                    get_type() != value_traits<T>::kind
+                    || (get_type() == CUSTOM && ops != ops_of<T>())
+                )
+                {
+                    throw Celery::Except::OutOfRange();
+                }
+
+                return unwrap<T>(stored);
             }
         }
+
+        template <typename T>
+        T get()
+        const {
+            return get<T>(default_value);
+        }
     };
-}
\ No newline at end of file
+}
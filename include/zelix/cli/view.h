@@ -0,0 +1,137 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/2/25.
+//
+
+#pragma once
+#include <cstddef>
+#include "celery/string/external.h"
+#include "convert.h"
+#include "error.h"
+
+namespace zelix::cli
+{
+    /**
+     * @brief A zero-copy `[begin, end)` window over the argv array.
+     *
+     * Views never own or copy the arguments they refer to, they
+     * only point into the array passed to the application, so
+     * they stay valid for as long as argv does.
+     */
+    class argv_view
+    {
+        const char **begin_ = nullptr;
+        const char **end_ = nullptr;
+        size_t offset = 0; ///< Position of `begin` in the argv array
+        const size_t *lens = nullptr; ///< Length of each element, if known
+
+    public:
+        explicit argv_view() = default;
+
+        explicit argv_view(
+            const char **begin,
+            const char **end,
+            const size_t offset,
+            const size_t *lens = nullptr
+        ) :
+            begin_(begin), end_(end), offset(offset), lens(lens)
+        {}
+
+        [[nodiscard]] const char **begin() const
+        {
+            return begin_;
+        }
+
+        [[nodiscard]] const char **end() const
+        {
+            return end_;
+        }
+
+        [[nodiscard]] size_t size() const
+        {
+            return end_ - begin_;
+        }
+
+        [[nodiscard]] bool empty() const
+        {
+            return begin_ == end_;
+        }
+
+        /**
+         * @brief Gets the position of the first element in the argv array.
+         */
+        [[nodiscard]] size_t argv_pos() const
+        {
+            return offset;
+        }
+
+        Celery::Str::External operator[](const size_t i) const
+        {
+            return lens == nullptr
+                ? Celery::Str::External(begin_[i])
+                : Celery::Str::External(begin_[i], lens[i]);
+        }
+
+        /**
+         * @brief Converts the i-th element of the view to the given type.
+         *
+         * Conversions are only done on access, so programs that only
+         * iterate over the raw pointers pay nothing for them.
+         *
+         * @param i The index of the element.
+         * @param out Where to store the converted value.
+         * @return Whether the conversion succeeded. On failure, the
+         *         global error is set to `TYPE_MISMATCH`.
+         */
+        template <typename T>
+        bool get(const size_t i, T &out) const
+        {
+            if (i >= size())
+            {
+                throw Celery::Except::OutOfRange();
+            }
+
+            if (!convert<T>((*this)[i], out))
+            {
+                global_error.error_type = error::TYPE_MISMATCH;
+                global_error.argv_pos = offset + i;
+                return false;
+            }
+
+            return true;
+        }
+
+        /**
+         * @brief Extends the view by one element.
+         * @note Only meant to be used by the parser.
+         */
+        void grow()
+        {
+            ++end_;
+        }
+    };
+}
@@ -0,0 +1,187 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/25/25.
+//
+
+#include <string>
+#include <thread>
+#include <vector>
+#include "check.h"
+#include "zelix/cli/app.h"
+#include "zelix/cli/cache.h"
+
+using namespace zelix;
+
+namespace
+{
+    const char *no_args[] = {"tool", nullptr};
+
+    void setup(cli::app &app)
+    {
+        app.command("run", "r", "Runs", false);
+        app.flag("jobs", "j", "Parallel jobs", 1);
+        app.flag("name", "n", "Name", Celery::Str::External("none"));
+    }
+
+    void hits_and_misses()
+    {
+        cli::app app("tool", "Does things", 1, no_args);
+        setup(app);
+        auto cache = app.cache(2);
+
+        const char *first[] = {"tool", "run", "-j", "2", nullptr};
+        const char *second[] = {"tool", "run", "-j", "3", nullptr};
+        const char *third[] = {"tool", "run", "-j", "4", nullptr};
+
+        const auto a = cache.parse(4, first);
+        CHECK(a != nullptr && a->flag<int>("jobs") == 2);
+        CHECK(cache.misses() == 1 && cache.hits() == 0);
+
+        const auto again = cache.parse(4, first);
+        CHECK(again == a); // The same shared result
+        CHECK(cache.hits() == 1);
+
+        // Bounded: the least recently used result goes first
+        CHECK(cache.parse(4, second) != nullptr);
+        CHECK(cache.parse(4, third) != nullptr);
+        CHECK(cache.size() == 2);
+
+        CHECK(cache.parse(4, first) != a);
+        CHECK(cache.misses() == 4);
+        CHECK(a->flag<int>("jobs") == 2); // Evicted results stay valid while shared
+
+        // Splitting arguments differently is another command line
+        const char *joined[] = {"tool", "run", "-j", "23", nullptr};
+        const char *split[] = {"tool", "run", "-j2", "3", nullptr};
+        CHECK(cache.parse(4, joined) != nullptr);
+        CHECK(cache.parse(4, split) == nullptr);
+        CHECK(cli::args::is_err());
+        CHECK(cache.misses() == 6);
+    }
+
+    void errors_not_cached()
+    {
+        cli::app app("tool", "Does things", 1, no_args);
+        setup(app);
+        auto cache = app.cache(4);
+
+        const char *argv[] = {"tool", "run", "-j", "many", nullptr};
+        CHECK(cache.parse(4, argv) == nullptr);
+        CHECK_ERROR(TYPE_MISMATCH);
+        CHECK(cache.parse(4, argv) == nullptr);
+        CHECK(cache.misses() == 2);
+        CHECK(cache.size() == 0);
+    }
+
+    void bound_flags_rejected()
+    {
+        int jobs = 0;
+        cli::app app("tool", "Does things", 1, no_args);
+        app.command("run", "r", "Runs", false);
+        app.flag("jobs", "j", "Parallel jobs", 1, &jobs);
+        CHECK_THROWS(app.cache(4));
+
+        // Binding after the cache was made is caught on the next miss
+        cli::app later("tool", "Does things", 1, no_args);
+        setup(later);
+        auto cache = later.cache(4);
+        later.flag("level", "l", "Level", 0, &jobs);
+
+        const char *argv[] = {"tool", "run", nullptr};
+        CHECK_THROWS(cache.parse(2, argv));
+    }
+
+    void many_threads()
+    {
+        cli::app app("tool", "Does things", 1, no_args);
+        setup(app);
+        auto cache = app.cache(8);
+
+        // More distinct lines than the capacity, so threads evict each other
+        std::vector<std::vector<std::string>> lines;
+        for (int i = 0; i < 16; ++i)
+        {
+            lines.push_back({"tool", "run", "-j", std::to_string(i), "--name", "n" + std::to_string(i)});
+        }
+
+        constexpr int threads = 8;
+        constexpr int rounds = 200;
+        std::vector<int> failures(threads, 0);
+        std::vector<std::thread> pool;
+
+        for (int t = 0; t < threads; ++t)
+        {
+            pool.emplace_back([&, t]
+            {
+                for (int round = 0; round < rounds; ++round)
+                {
+                    const int i = (round * 7 + t) % static_cast<int>(lines.size());
+                    const char *argv[7];
+                    for (size_t k = 0; k < 6; ++k)
+                    {
+                        argv[k] = lines[i][k].c_str();
+                    }
+
+                    argv[6] = nullptr;
+
+                    const auto result = cache.parse(6, argv);
+                    if (
+                        result == nullptr
+                        || result->flag<int>("jobs") != i
+                        || result->flag<Celery::Str::External>("name").Size() != lines[i][5].size()
+                    )
+                    {
+                        ++failures[t];
+                    }
+                }
+            });
+        }
+
+        for (auto &thread : pool)
+        {
+            thread.join();
+        }
+
+        for (const int count : failures)
+        {
+            CHECK(count == 0);
+        }
+
+        CHECK(cache.hits() + cache.misses() == threads * rounds);
+        CHECK(cache.misses() >= lines.size());
+        CHECK(cache.size() <= 8);
+    }
+}
+
+int main()
+{
+    hits_and_misses();
+    errors_not_cached();
+    bound_flags_rejected();
+    many_threads();
+    return cli::test::result();
+}
@@ -0,0 +1,157 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/25/25.
+//
+
+#include "check.h"
+#include "zelix/cli/app.h"
+
+using namespace zelix;
+
+namespace
+{
+    void setup(cli::app &app)
+    {
+        app.command("build", "b", "Builds", false);
+        app.command("test", "t", "Tests", false);
+        app.command("package", "p", "Packages", Celery::Str::External("tar"));
+        app.flag("release", "r", "Optimize", false);
+        app.flag("jobs", "j", "Parallel jobs", 1);
+    }
+
+    void several_segments()
+    {
+        const char *argv[] = {"tool", "build", "--release", "+", "test", "--jobs=8", "+", "package", "zip", nullptr};
+        cli::app app("tool", "Does things", 9, argv);
+        setup(app);
+
+        auto chain = app.parse_chain();
+        CHECK(!cli::args::is_err());
+        CHECK(chain.size() == 3);
+        if (chain.size() != 3)
+        {
+            return;
+        }
+
+        // Each segment only sees its own flags
+        CHECK_STR(chain[0].get_cmd(), "build");
+        CHECK(chain[0].flag<bool>("release"));
+        CHECK(chain[0].flag<int>("jobs") == 1);
+
+        CHECK_STR(chain[1].get_cmd(), "test");
+        CHECK(!chain[1].flag<bool>("release"));
+        CHECK(chain[1].flag<int>("jobs") == 8);
+
+        CHECK_STR(chain[2].get_cmd(), "package");
+        CHECK_STR(chain[2].command<Celery::Str::External>("package"), "zip");
+    }
+
+    void custom_delimiter()
+    {
+        const char *argv[] = {"tool", "build", "then", "test", nullptr};
+        cli::app app("tool", "Does things", 4, argv);
+        setup(app);
+
+        const auto chain = app.parse_chain("then");
+        CHECK(!cli::args::is_err());
+        CHECK(chain.size() == 2);
+    }
+
+    void empty_segment()
+    {
+        const char *argv[] = {"tool", "build", "+", "+", "test", nullptr};
+        cli::app app("tool", "Does things", 5, argv);
+        setup(app);
+
+        // The failed segment is the last one
+        auto chain = app.parse_chain();
+        CHECK(chain.size() == 2);
+        CHECK_ERROR(EXPECTED_VALUE);
+        CHECK(cli::global_error.argv_pos == 3);
+
+        const char *trailing[] = {"tool", "build", "+", nullptr};
+        cli::app other("tool", "Does things", 3, trailing);
+        setup(other);
+
+        CHECK(other.parse_chain().size() == 2);
+        CHECK_ERROR(EXPECTED_VALUE);
+    }
+
+    void error_in_segment()
+    {
+        const char *argv[] = {"tool", "build", "+", "test", "--jobs=many", "+", "package", nullptr};
+        cli::app app("tool", "Does things", 7, argv);
+        setup(app);
+
+        auto chain = app.parse_chain();
+        CHECK(chain.size() == 2);
+        CHECK_ERROR(TYPE_MISMATCH);
+        CHECK(cli::global_error.argv_pos == 4);
+        CHECK(chain.size() == 2 && chain[0].flag<int>("jobs") == 1); // Earlier segments are kept
+
+        const char *unknown[] = {"tool", "build", "+", "deploy", nullptr};
+        cli::app other("tool", "Does things", 4, unknown);
+        setup(other);
+
+        CHECK(other.parse_chain().size() == 2);
+        CHECK_ERROR(UNKNOWN_COMMAND);
+        CHECK(cli::global_error.argv_pos == 3);
+    }
+
+    void lazy_segments()
+    {
+        const char *argv[] = {"tool", "test", "-j", "many", "+", "test", "-j", "3", nullptr};
+        cli::app app("tool", "Does things", 8, argv);
+        setup(app);
+
+        // Conversions are deferred, so every segment is read
+        auto chain = app.parse_chain<true>();
+        CHECK(!cli::args::is_err());
+        CHECK(chain.size() == 2);
+        if (chain.size() != 2)
+        {
+            return;
+        }
+
+        CHECK(chain[1].flag<int>("jobs") == 3);
+        CHECK(!cli::args::is_err());
+
+        chain[0].flag<int>("jobs");
+        CHECK_ERROR(TYPE_MISMATCH);
+        CHECK(cli::global_error.argv_pos == 3);
+    }
+}
+
+int main()
+{
+    several_segments();
+    custom_delimiter();
+    empty_segment();
+    error_in_segment();
+    lazy_segments();
+    return cli::test::result();
+}
@@ -0,0 +1,84 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/25/25.
+//
+
+#pragma once
+#include <cstdio>
+#include <cstring>
+#include "celery/except/base.h"
+#include "celery/string/external.h"
+#include "zelix/cli/error.h"
+
+/**
+ * @brief Minimal assertions for the behaviour tests.
+ *
+ * Every test is a plain executable run by ctest. Failed checks are
+ * printed and counted, and `main` returns `zelix::cli::test::result()`.
+ */
+namespace zelix::cli::test
+{
+    inline int failures = 0;
+
+    inline void fail(const char *file, const int line, const char *expr)
+    {
+        fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expr);
+        ++failures;
+    }
+
+    inline bool equals(const Celery::Str::External &str, const char *expected)
+    {
+        return str.Size() == strlen(expected) && memcmp(str.Ptr(), expected, str.Size()) == 0;
+    }
+
+    inline int result()
+    {
+        if (failures != 0)
+        {
+            fprintf(stderr, "%d check(s) failed\n", failures);
+        }
+
+        return failures == 0 ? 0 : 1;
+    }
+}
+
+#define CHECK(expr) \
+    do { if (!(expr)) zelix::cli::test::fail(__FILE__, __LINE__, #expr); } while (false)
+
+#define CHECK_STR(str, expected) \
+    CHECK(zelix::cli::test::equals((str), (expected)))
+
+#define CHECK_ERROR(type) \
+    CHECK(zelix::cli::global_error.error_type == zelix::cli::error::type)
+
+#define CHECK_THROWS(expr) \
+    do \
+    { \
+        bool thrown = false; \
+        try { (void) (expr); } catch (const Celery::Except::Exception &) { thrown = true; } \
+        if (!thrown) zelix::cli::test::fail(__FILE__, __LINE__, "throws " #expr); \
+    } while (false)
@@ -0,0 +1,115 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/25/25.
+//
+
+#include <string>
+#include <vector>
+#include "check.h"
+#include "zelix/cli/app.h"
+
+using namespace zelix;
+
+namespace
+{
+    const char *no_args[] = {"tool", nullptr};
+    const cli::choice_set modes({"debug", "release", "profile"});
+
+    void resolves_to_ids()
+    {
+        cli::app app("tool", "Does things", 1, no_args);
+        app.command("build", "b", "Builds", false);
+        app.flag("mode", "m", "Build mode", cli::choice(modes, 0));
+
+        const char *given[] = {"tool", "build", "--mode=profile", nullptr};
+        auto args = app.parse(3, given);
+        CHECK(!cli::args::is_err());
+        CHECK(args.flag<cli::choice>("mode").id() == 2);
+        CHECK_STR(args.flag<cli::choice>("mode").str(), "profile");
+
+        const char *missing[] = {"tool", "build", nullptr};
+        auto defaults = app.parse(2, missing);
+        CHECK(defaults.flag<cli::choice>("mode").id() == 0);
+
+        const char *invalid[] = {"tool", "build", "-m", "fast", nullptr};
+        app.parse(4, invalid);
+        CHECK_ERROR(INVALID_CHOICE);
+        CHECK(cli::global_error.argv_pos == 3);
+    }
+
+    void rejects_duplicates()
+    {
+        CHECK_THROWS(cli::choice_set({"a", "b", "a"}));
+    }
+
+    void large_sets()
+    {
+        // Far past the point where a collision-free seed can be found
+        for (const size_t count : {200, 1000, 5000})
+        {
+            std::vector<std::string> names;
+            for (size_t i = 0; i < count; ++i)
+            {
+                names.push_back("option-" + std::to_string(i));
+            }
+
+            std::vector<Celery::Str::External> keys;
+            for (const auto &name : names)
+            {
+                keys.emplace_back(name.c_str(), name.size());
+            }
+
+            const cli::choice_set set(keys);
+            CHECK(set.size() == count);
+
+            bool all_found = true;
+            for (size_t i = 0; i < count; ++i)
+            {
+                all_found = all_found && set.find(keys[i]) == i;
+            }
+
+            CHECK(all_found);
+            CHECK(set.find(Celery::Str::External("option-x")) == cli::perfect_hash::NONE);
+            CHECK(set.find(Celery::Str::External("")) == cli::perfect_hash::NONE);
+        }
+    }
+
+    void empty_set()
+    {
+        const cli::perfect_hash table(nullptr, 0);
+        CHECK(table.find(Celery::Str::External("a")) == cli::perfect_hash::NONE);
+    }
+}
+
+int main()
+{
+    resolves_to_ids();
+    rejects_duplicates();
+    large_sets();
+    empty_set();
+    return cli::test::result();
+}
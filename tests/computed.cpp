@@ -0,0 +1,197 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/25/25.
+//
+
+#include <cstdlib>
+#include "check.h"
+#include "zelix/cli/app.h"
+
+using namespace zelix;
+
+namespace
+{
+    /**
+     * @brief A range whose parse only fills in its upper end.
+     */
+    struct span
+    {
+        int lo;
+        int hi;
+    };
+}
+
+template <>
+struct zelix::cli::value_traits<span>
+{
+    static constexpr auto kind = zelix::cli::value::CUSTOM;
+
+    static bool parse(const Celery::Str::External &text, span &out)
+    {
+        return convert(text, out.hi);
+    }
+
+    static void describe(const span &, Celery::Str::String &out)
+    {
+        out.Write("span", 4);
+    }
+
+    static void format(const span &val, Celery::Str::String &out)
+    {
+        const auto str = std::to_string(val.lo) + ".." + std::to_string(val.hi);
+        out.Write(str.c_str(), str.size());
+    }
+};
+
+namespace
+{
+    const char *no_args[] = {"tool", nullptr};
+
+    int job_calls = 0;
+    int span_calls = 0;
+
+    void setup(cli::app &app)
+    {
+        job_calls = 0;
+        span_calls = 0;
+
+        app.command("run", "r", "Runs", false);
+        app.flag("jobs", "j", "Parallel jobs", cli::computed([]
+        {
+            ++job_calls;
+            return 8;
+        }));
+
+        app.flag("range", "R", "Range", cli::computed([]
+        {
+            ++span_calls;
+            return span{1, 9};
+        }));
+    }
+
+    void computed_once_when_missing()
+    {
+        cli::app app("tool", "Does things", 1, no_args);
+        setup(app);
+
+        const char *argv[] = {"tool", "run", nullptr};
+        auto args = app.parse(2, argv);
+        CHECK(!cli::args::is_err());
+
+        CHECK(args.flag<int>("jobs") == 8);
+        CHECK(args.flag<int>("jobs") == 8);
+        CHECK(job_calls == 1);
+
+        const auto range = args.flag<span>("range");
+        CHECK(range.lo == 1 && range.hi == 9);
+        CHECK(span_calls == 1);
+    }
+
+    void not_computed_when_given()
+    {
+        cli::app app("tool", "Does things", 1, no_args);
+        setup(app);
+
+        const char *argv[] = {"tool", "run", "-j", "4", "-R", "5", nullptr};
+        auto args = app.parse(6, argv);
+        CHECK(!cli::args::is_err());
+
+        CHECK(args.flag<int>("jobs") == 4);
+
+        // Given values are parsed from a blank value, not the computed one
+        const auto range = args.flag<span>("range");
+        CHECK(range.lo == 0 && range.hi == 5);
+
+        CHECK(job_calls == 0);
+        CHECK(span_calls == 0);
+    }
+
+    void not_computed_when_given_lazily()
+    {
+        cli::app app("tool", "Does things", 1, no_args);
+        setup(app);
+
+        const char *argv[] = {"tool", "run", "--range=7", nullptr};
+        auto args = app.parse<true>(3, argv);
+        CHECK(!cli::args::is_err());
+
+        CHECK(args.flag<span>("range").hi == 7);
+        CHECK(span_calls == 0);
+    }
+
+    void not_computed_from_environment()
+    {
+        cli::app app("tool", "Does things", 1, no_args);
+        job_calls = 0;
+        app.command("run", "r", "Runs", false);
+        app.flag("jobs", "j", "Parallel jobs", cli::computed([]
+        {
+            ++job_calls;
+            return 8;
+        }), "ZELIX_CLI_TEST_JOBS");
+
+        setenv("ZELIX_CLI_TEST_JOBS", "3", 1);
+
+        const char *argv[] = {"tool", "run", nullptr};
+        auto args = app.parse(2, argv);
+        CHECK(!cli::args::is_err());
+        CHECK(args.flag<int>("jobs") == 3);
+        CHECK(job_calls == 0);
+
+        unsetenv("ZELIX_CLI_TEST_JOBS");
+    }
+
+    void cannot_be_frozen()
+    {
+        cli::app app("tool", "Does things", 1, no_args);
+        setup(app);
+
+        CHECK_THROWS(app.freeze());
+    }
+
+    void values_stay_small()
+    {
+        // Computed defaults live in the schema, values only hold their fixed fields
+        constexpr size_t fields = sizeof(size_t)
+            + sizeof(Celery::Str::External)
+            + sizeof(void *)
+            + sizeof(cli::value::storage);
+
+        CHECK(sizeof(cli::value) <= fields);
+    }
+}
+
+int main()
+{
+    computed_once_when_missing();
+    not_computed_when_given();
+    not_computed_when_given_lazily();
+    not_computed_from_environment();
+    cannot_be_frozen();
+    values_stay_small();
+    return cli::test::result();
+}
@@ -0,0 +1,153 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/25/25.
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "check.h"
+#include "zelix/cli/app.h"
+
+using namespace zelix;
+
+namespace
+{
+    const char *no_args[] = {"tool", nullptr};
+
+    void write_file(const char *path, const char *text)
+    {
+        FILE *file = fopen(path, "w");
+        fputs(text, file);
+        fclose(file);
+    }
+
+    void precedence()
+    {
+        // The environment is indexed once, so it is set up before any lookup
+        setenv("TOOL_JOBS", "8", 1);
+        write_file(
+            "config_precedence.ini",
+            "# Defaults\n"
+            "jobs = 2\n"
+            "name = \"from file\"\n"
+            "level = 3\n"
+            "[run]\n"
+            "level = 5\n"
+        );
+
+        cli::app app("tool", "Does things", 1, no_args);
+        app.command("run", "r", "Runs", false);
+        app.command("stop", "s", "Stops", false);
+        app.flag("jobs", "j", "Parallel jobs", 1, "TOOL_JOBS");
+        app.flag("name", "n", "Name", Celery::Str::External("none"));
+        app.flag("level", "l", "Level", 0);
+        app.flag("other", "o", "Not in the file", 7);
+        CHECK(app.config("config_precedence.ini"));
+
+        const char *run[] = {"tool", "run", nullptr};
+        auto from_file = app.parse(2, run);
+        CHECK(!cli::args::is_err());
+        CHECK(from_file.flag<int>("jobs") == 8); // The environment wins over the file
+        CHECK(from_file.source_of("jobs") == cli::args::ENV);
+        CHECK_STR(from_file.flag<Celery::Str::External>("name"), "from file");
+        CHECK(from_file.source_of("name") == cli::args::CONFIG);
+        CHECK(from_file.flag<int>("level") == 5); // The section overrides the global key
+        CHECK(from_file.flag<int>("other") == 7);
+        CHECK(from_file.source_of("other") == cli::args::DEFAULT);
+
+        const char *stop[] = {"tool", "stop", "--jobs=3", "-n", "given", nullptr};
+        auto from_argv = app.parse(5, stop);
+        CHECK(!cli::args::is_err());
+        CHECK(from_argv.flag<int>("jobs") == 3);
+        CHECK_STR(from_argv.flag<Celery::Str::External>("name"), "given");
+        CHECK(from_argv.flag<int>("level") == 3); // [run] does not apply
+    }
+
+    void bound_c_string()
+    {
+        write_file("config_c_string.ini", "name = abc\njobs = 12\n");
+
+        const char *name = nullptr;
+        cli::app app("tool", "Does things", 1, no_args);
+        app.command("run", "r", "Runs", false);
+        app.flag("name", "n", "Name", "none", &name);
+        app.flag("jobs", "j", "Parallel jobs", 1);
+        CHECK(app.config("config_c_string.ini"));
+
+        const char *argv[] = {"tool", "run", nullptr};
+        const auto args = app.parse(2, argv);
+        CHECK(!cli::args::is_err());
+        CHECK(name != nullptr && strcmp(name, "abc") == 0);
+    }
+
+    void invalid_value()
+    {
+        write_file("config_invalid.ini", "jobs = many\n");
+
+        cli::app app("tool", "Does things", 1, no_args);
+        app.command("run", "r", "Runs", false);
+        app.flag("jobs", "j", "Parallel jobs", 1);
+        CHECK(app.config("config_invalid.ini"));
+
+        const char *argv[] = {"tool", "run", nullptr};
+        app.parse(2, argv);
+        CHECK_ERROR(INVALID_CONFIG);
+        CHECK_STR(cli::global_error.source, "jobs");
+    }
+
+    void unterminated_section()
+    {
+        write_file("config_section.ini", "jobs = 2\n[run\nlevel = 5\n");
+
+        cli::app app("tool", "Does things", 1, no_args);
+        app.command("run", "r", "Runs", false);
+        app.flag("jobs", "j", "Parallel jobs", 1);
+
+        cli::global_error = cli::error();
+        CHECK(!app.config("config_section.ini"));
+        CHECK_ERROR(MALFORMED_CONFIG);
+        CHECK(cli::global_error.offset == 9);
+        CHECK_STR(cli::global_error.source, "[run");
+    }
+
+    void missing_file()
+    {
+        cli::app app("tool", "Does things", 1, no_args);
+        CHECK(!app.config("config_does_not_exist.ini"));
+    }
+}
+
+int main()
+{
+    precedence();
+    bound_c_string();
+    invalid_value();
+    unterminated_section();
+    missing_file();
+    return cli::test::result();
+}
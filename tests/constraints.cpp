@@ -0,0 +1,161 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/25/25.
+//
+
+#include "check.h"
+#include "zelix/cli/app.h"
+
+using namespace zelix;
+
+namespace
+{
+    const char *no_args[] = {"cc", nullptr};
+
+    void setup(cli::app &app)
+    {
+        app.command("build", "b", "Builds", false);
+        const size_t release = app.flag("release", "r", "Optimize", false);
+        const size_t debug = app.flag("debug", "g", "Keep symbols", false);
+        const size_t strip = app.flag("strip", "s", "Strip symbols", false);
+        app.flag("out", "o", "Output", Celery::Str::External("a.out"));
+
+        app.require(app.slot_of("out"));
+        app.exclusive({release, debug});
+        app.depends(strip, {release});
+    }
+
+    void satisfied()
+    {
+        cli::app app("cc", "Compiles things", 1, no_args);
+        setup(app);
+
+        const char *argv[] = {"cc", "build", "-o", "x", "--release", "--strip", nullptr};
+        app.parse(6, argv);
+        CHECK(!cli::args::is_err());
+    }
+
+    void missing_required()
+    {
+        cli::app app("cc", "Compiles things", 1, no_args);
+        setup(app);
+
+        const char *argv[] = {"cc", "build", "--release", nullptr};
+        app.parse(3, argv);
+        CHECK_ERROR(MISSING_REQUIRED);
+        CHECK_STR(cli::global_error.source, "out");
+    }
+
+    void exclusive_flags()
+    {
+        cli::app app("cc", "Compiles things", 1, no_args);
+        setup(app);
+
+        const char *argv[] = {"cc", "build", "-g", "-o", "x", "-r", nullptr};
+        app.parse(6, argv);
+
+        // The last one given is blamed, pointing back at the first
+        CHECK_ERROR(CONFLICTING_ARGUMENTS);
+        CHECK(cli::global_error.argv_pos == 5);
+        CHECK_STR(cli::global_error.source, "debug");
+    }
+
+    void unmet_dependency()
+    {
+        cli::app app("cc", "Compiles things", 1, no_args);
+        setup(app);
+
+        const char *argv[] = {"cc", "build", "-o", "x", "--strip", nullptr};
+        app.parse(5, argv);
+        CHECK_ERROR(MISSING_DEPENDENCY);
+        CHECK(cli::global_error.argv_pos == 4);
+        CHECK_STR(cli::global_error.source, "release");
+    }
+
+    void command_owned_flags()
+    {
+        cli::app app("cc", "Compiles things", 1, no_args);
+        app.command("link", "l", "Links", false, [](cli::app &link)
+        {
+            const size_t lto = link.flag("lto", "t", "Link-time optimization", false);
+            const size_t opt = link.flag("opt", "O", "Optimization level", 0);
+            const size_t fast = link.flag("fast", "f", "Fast linker", false);
+            link.depends(lto, {opt});
+            link.exclusive({lto, fast});
+        });
+
+        const char *unmet[] = {"cc", "link", "--lto", nullptr};
+        app.parse(3, unmet);
+        CHECK_ERROR(MISSING_DEPENDENCY);
+        CHECK_STR(cli::global_error.source, "opt");
+
+        const char *conflict[] = {"cc", "link", "--lto", "-O", "2", "--fast", nullptr};
+        app.parse(6, conflict);
+        CHECK_ERROR(CONFLICTING_ARGUMENTS);
+        CHECK_STR(cli::global_error.source, "lto");
+
+        const char *ok[] = {"cc", "link", "-O", "2", "--lto", nullptr};
+        const auto args = app.parse(5, ok);
+        CHECK(!cli::args::is_err());
+    }
+
+    void other_command_required()
+    {
+        cli::app app("cc", "Compiles things", 1, no_args);
+        app.command("link", "l", "Links", false, [](cli::app &link)
+        {
+            link.require(link.flag("output", "o", "Output", Celery::Str::External("a.out")));
+        });
+
+        app.command("clean", "c", "Cleans", false);
+
+        const char *link[] = {"cc", "link", nullptr};
+        app.parse(2, link);
+        CHECK_ERROR(MISSING_REQUIRED);
+        CHECK_STR(cli::global_error.source, "output");
+
+        // The flag stays registered, but only exists under "link"
+        const char *clean[] = {"cc", "clean", nullptr};
+        app.parse(2, clean);
+        CHECK(!cli::args::is_err());
+
+        const char *given[] = {"cc", "link", "-o", "x", nullptr};
+        app.parse(4, given);
+        CHECK(!cli::args::is_err());
+    }
+}
+
+int main()
+{
+    satisfied();
+    missing_required();
+    exclusive_flags();
+    unmet_dependency();
+    command_owned_flags();
+    other_command_required();
+    return cli::test::result();
+}
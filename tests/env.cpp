@@ -0,0 +1,130 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/25/25.
+//
+
+#include "check.h"
+#include "zelix/cli/app.h"
+
+using namespace zelix;
+
+namespace
+{
+    const char *no_args[] = {"tool", nullptr};
+
+    /**
+     * @brief The environment of every test, installed before the first lookup.
+     *
+     * The index is a snapshot taken the first time a variable is needed,
+     * so everything must be defined up front.
+     */
+    char jobs[] = "TOOL_JOBS=3";
+    char jobs_again[] = "TOOL_JOBS=9";
+    char ratio[] = "TOOL_RATIO=fast";
+    char name[] = "TOOL_NAME=from-env";
+    char *fake_environ[] = {jobs, ratio, jobs_again, name, nullptr};
+
+    void setup(cli::app &app)
+    {
+        app.command("run", "r", "Runs", false);
+        app.flag("jobs", "j", "Parallel jobs", 1, "TOOL_JOBS");
+        app.flag("ratio", "R", "Ratio", 1.0f, "TOOL_RATIO");
+        app.flag("name", "n", "Name", Celery::Str::External("none"), "TOOL_NAME");
+        app.flag("home", "H", "Home", Celery::Str::External("~"), "TOOL_UNSET");
+    }
+
+    void first_definition_wins()
+    {
+        cli::app app("tool", "Does things", 1, no_args);
+        setup(app);
+
+        const char *argv[] = {"tool", "run", "--ratio=2", nullptr};
+        auto args = app.parse(3, argv);
+        CHECK(!cli::args::is_err());
+
+        // Like getenv(), duplicate entries resolve to the first one
+        CHECK(args.flag<int>("jobs") == 3);
+        CHECK(args.source_of("jobs") == cli::args::ENV);
+        CHECK_STR(args.flag<Celery::Str::External>("name"), "from-env");
+
+        // Undefined variables fall back to the default
+        CHECK_STR(args.flag<Celery::Str::External>("home"), "~");
+        CHECK(args.source_of("home") == cli::args::DEFAULT);
+    }
+
+    void argv_wins()
+    {
+        cli::app app("tool", "Does things", 1, no_args);
+        setup(app);
+
+        const char *argv[] = {"tool", "run", "-j", "5", "--name=cli", "--ratio=2", nullptr};
+        auto args = app.parse(6, argv);
+        CHECK(!cli::args::is_err());
+
+        CHECK(args.flag<int>("jobs") == 5);
+        CHECK(args.source_of("jobs") == cli::args::ARGV);
+        CHECK_STR(args.flag<Celery::Str::External>("name"), "cli");
+    }
+
+    void conversion_error_names_variable()
+    {
+        cli::app app("tool", "Does things", 1, no_args);
+        setup(app);
+
+        const char *argv[] = {"tool", "run", nullptr};
+        app.parse(2, argv);
+
+        CHECK_ERROR(INVALID_ENV);
+        CHECK(cli::global_error.argv_pos == 0);
+        CHECK_STR(cli::global_error.source, "TOOL_RATIO");
+    }
+
+    void lazy_conversion_error_names_variable()
+    {
+        cli::app app("tool", "Does things", 1, no_args);
+        setup(app);
+
+        const char *argv[] = {"tool", "run", nullptr};
+        auto args = app.parse<true>(2, argv);
+        CHECK(!cli::args::is_err());
+
+        args.flag<float>("ratio");
+        CHECK_ERROR(INVALID_ENV);
+        CHECK_STR(cli::global_error.source, "TOOL_RATIO");
+    }
+}
+
+int main()
+{
+    environ = fake_environ;
+
+    first_definition_wins();
+    argv_wins();
+    conversion_error_names_variable();
+    lazy_conversion_error_names_variable();
+    return cli::test::result();
+}
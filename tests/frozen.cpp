@@ -0,0 +1,189 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/25/25.
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "check.h"
+#include "zelix/cli/app.h"
+
+using namespace zelix;
+
+namespace
+{
+    const char *no_args[] = {"tool", nullptr};
+    const cli::choice_set modes({"debug", "release"});
+
+    void setup(cli::app &app)
+    {
+        app.command("build", "b", "Builds", Celery::Str::External("all"));
+        app.command("clean", "c", "Cleans", false);
+        app.flag("jobs", "j", "Parallel jobs", 1, "FROZEN_TEST_JOBS");
+        app.flag("ratio", "r", "Ratio", 1.0f);
+        app.flag("verbose", "v", "Verbose output", false);
+        const size_t name = app.flag("name", "n", "Name", Celery::Str::External("none"));
+        const size_t mode = app.flag("mode", "m", "Build mode", cli::choice(modes, 0));
+        app.positional("inputs", "Files", true);
+        app.exclusive({name, mode});
+    }
+
+    void write_image(const std::vector<unsigned char> &bytes)
+    {
+        FILE *file = fopen("frozen.schema", "wb");
+        fwrite(bytes.data(), 1, bytes.size(), file);
+        fclose(file);
+    }
+
+    void round_trip()
+    {
+        cli::app app("tool", "Does things", 1, no_args);
+        setup(app);
+        write_image(app.freeze());
+
+        cli::schema_image image;
+        CHECK(image.open("frozen.schema"));
+        CHECK_STR(image.name(), "tool");
+
+        setenv("FROZEN_TEST_JOBS", "6", 1);
+        const char *argv[] = {"tool", "b", "lib", "-r", "0.5", "--verbose", "--mode=release", "a.c", "b.c", nullptr};
+        cli::app worker(image, 9, argv);
+        auto args = worker.parse();
+        CHECK(!cli::args::is_err());
+
+        CHECK_STR(args.command<Celery::Str::External>("build"), "lib");
+        CHECK(args.flag<int>("jobs") == 6);
+        CHECK(args.source_of("jobs") == cli::args::ENV);
+        CHECK(args.flag<float>("ratio") == 0.5f);
+        CHECK(args.flag<bool>("verbose"));
+        CHECK_STR(args.flag<cli::choice>("mode").str(), "release");
+        CHECK_STR(args.flag<Celery::Str::External>("name"), "none");
+        CHECK(args.positional("inputs").size() == 2);
+        CHECK_STR(args.positional("inputs")[1], "b.c");
+
+        CHECK(worker.slot_of("clean") == app.slot_of("clean"));
+        CHECK(worker.slot_of("mode") == app.slot_of("mode"));
+        CHECK(strcmp(worker.help().c_str(), app.help().c_str()) == 0);
+        unsetenv("FROZEN_TEST_JOBS");
+    }
+
+    void errors()
+    {
+        cli::app app("tool", "Does things", 1, no_args);
+        setup(app);
+        const auto bytes = app.freeze();
+
+        cli::schema_image image;
+        image.attach(bytes.data(), bytes.size());
+        cli::app worker(image, 1, no_args);
+
+        const char *unknown_flag[] = {"tool", "clean", "--jobz", "2", nullptr};
+        worker.parse(4, unknown_flag);
+        CHECK_ERROR(UNKNOWN_FLAG);
+        CHECK(cli::global_error.argv_pos == 2);
+
+        const char *unknown_command[] = {"tool", "cleanup", nullptr};
+        worker.parse(2, unknown_command);
+        CHECK_ERROR(UNKNOWN_COMMAND);
+
+        const char *exclusive[] = {"tool", "c", "-n", "x", "-m", "debug", nullptr};
+        worker.parse(6, exclusive);
+        CHECK_ERROR(CONFLICTING_ARGUMENTS);
+
+        const char *invalid_choice[] = {"tool", "c", "-m", "fast", nullptr};
+        worker.parse(4, invalid_choice);
+        CHECK_ERROR(INVALID_CHOICE);
+
+        CHECK_THROWS(worker.flag("more", "x", "More", false));
+    }
+
+    void many_flags()
+    {
+        // Large sets fall back to probing tables, which are stored the same way
+        std::vector<std::string> names;
+        std::vector<std::string> aliases;
+        for (size_t i = 0; i < 900; ++i)
+        {
+            names.push_back("flag-" + std::to_string(i));
+            aliases.push_back("f" + std::to_string(i));
+        }
+
+        cli::app app("tool", "Does things", 1, no_args);
+        app.command("run", "r", "Runs", false);
+        for (size_t i = 0; i < names.size(); ++i)
+        {
+            app.flag(names[i].c_str(), aliases[i].c_str(), "A flag", static_cast<int>(i));
+        }
+
+        const auto bytes = app.freeze();
+        cli::schema_image image;
+        image.attach(bytes.data(), bytes.size());
+
+        const char *argv[] = {"tool", "r", "--flag-899", "1", "-f450", "2", "--flag-0=3", nullptr};
+        cli::app worker(image, 7, argv);
+        auto args = worker.parse();
+        CHECK(!cli::args::is_err());
+
+        CHECK(args.flag<int>("flag-899") == 1);
+        CHECK(args.flag<int>("flag-450") == 2);
+        CHECK(args.flag<int>("flag-0") == 3);
+        CHECK(args.flag<int>("flag-123") == 123);
+
+        for (size_t i = 0; i < names.size(); ++i)
+        {
+            CHECK(worker.slot_of(names[i].c_str()) == app.slot_of(names[i].c_str()));
+        }
+
+        const char *unknown[] = {"tool", "r", "--flag-900", "1", nullptr};
+        worker.parse(4, unknown);
+        CHECK_ERROR(UNKNOWN_FLAG);
+    }
+
+    void rejects_foreign_buffers()
+    {
+        std::vector<unsigned char> bytes(256, 0);
+        cli::schema_image image;
+        CHECK_THROWS(image.attach(bytes.data(), bytes.size()));
+
+        cli::app app("tool", "Does things", 1, no_args);
+        setup(app);
+        auto frozen = app.freeze();
+        CHECK_THROWS(image.attach(frozen.data(), frozen.size() / 2));
+    }
+}
+
+int main()
+{
+    round_trip();
+    errors();
+    many_flags();
+    rejects_foreign_buffers();
+    return cli::test::result();
+}
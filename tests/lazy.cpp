@@ -0,0 +1,121 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/25/25.
+//
+
+#include "check.h"
+#include "zelix/cli/app.h"
+
+using namespace zelix;
+
+namespace
+{
+    const char *no_args[] = {"tool", nullptr};
+
+    void setup(cli::app &app)
+    {
+        app.command("run", "r", "Runs", false);
+        app.flag("jobs", "j", "Parallel jobs", 1);
+        app.flag("ratio", "R", "Ratio", 1.0f);
+        app.flag("name", "n", "Name", Celery::Str::External("none"));
+    }
+
+    void converts_on_access()
+    {
+        cli::app app("tool", "Does things", 1, no_args);
+        setup(app);
+
+        const char *argv[] = {"tool", "run", "-j", "4", "--ratio=0.5", nullptr};
+        auto args = app.parse<true>(5, argv);
+        CHECK(!cli::args::is_err());
+
+        CHECK(args.flag<int>("jobs") == 4);
+        CHECK(args.flag<int>("jobs") == 4); // Memoized
+        CHECK(args.flag<float>("ratio") == 0.5f);
+        CHECK_STR(args.flag<Celery::Str::External>("name"), "none");
+        CHECK(!cli::args::is_err());
+    }
+
+    void errors_on_access()
+    {
+        cli::app app("tool", "Does things", 1, no_args);
+        setup(app);
+
+        const char *argv[] = {"tool", "run", "-j", "many", nullptr};
+        auto args = app.parse<true>(4, argv);
+
+        // Nothing is converted while parsing
+        CHECK(!cli::args::is_err());
+
+        args.flag<int>("jobs");
+        CHECK_ERROR(TYPE_MISMATCH);
+        CHECK(cli::global_error.argv_pos == 3);
+    }
+
+    void errors_on_every_access()
+    {
+        cli::app app("tool", "Does things", 1, no_args);
+        setup(app);
+
+        const char *argv[] = {"tool", "run", "-j", "many", "--ratio=0.5", nullptr};
+        auto args = app.parse<true>(5, argv);
+        CHECK(!cli::args::is_err());
+
+        CHECK(args.flag<int>("jobs") == 1); // The default
+        CHECK_ERROR(TYPE_MISMATCH);
+
+        // Reading another flag starts from a clean error
+        cli::global_error = cli::error();
+        CHECK(args.flag<float>("ratio") == 0.5f);
+        CHECK(!cli::args::is_err());
+
+        // The failure is reported again, not hidden behind the default
+        CHECK(args.flag<int>("jobs") == 1);
+        CHECK_ERROR(TYPE_MISMATCH);
+        CHECK(cli::global_error.argv_pos == 3);
+    }
+
+    void eager_errors_while_parsing()
+    {
+        cli::app app("tool", "Does things", 1, no_args);
+        setup(app);
+
+        const char *argv[] = {"tool", "run", "-j", "many", nullptr};
+        app.parse(4, argv);
+        CHECK_ERROR(TYPE_MISMATCH);
+        CHECK(cli::global_error.argv_pos == 3);
+    }
+}
+
+int main()
+{
+    converts_on_access();
+    errors_on_access();
+    errors_on_every_access();
+    eager_errors_while_parsing();
+    return cli::test::result();
+}
@@ -0,0 +1,176 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/25/25.
+//
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include "check.h"
+#include "zelix/cli/app.h"
+
+using namespace zelix;
+
+namespace
+{
+    const char *no_args[] = {"tool", nullptr};
+
+    void setup(cli::app &app, const cli::parse_limits &limits)
+    {
+        app.command("run", "r", "Runs", false);
+        app.flag("name", "n", "Name", Celery::Str::External("none"));
+        app.positional("inputs", "Files", true);
+        app.limit(limits);
+    }
+
+    void tokens()
+    {
+        cli::app app("tool", "Does things", 1, no_args);
+        setup(app, {.tokens = 3});
+
+        const char *within[] = {"tool", "run", "a", "b", nullptr};
+        app.parse(4, within);
+        CHECK(!cli::args::is_err());
+
+        const char *past[] = {"tool", "run", "a", "b", "c", nullptr};
+        app.parse(5, past);
+        CHECK_ERROR(LIMIT_EXCEEDED);
+        CHECK(cli::global_error.argv_pos == 4);
+    }
+
+    void token_length()
+    {
+        cli::app app("tool", "Does things", 1, no_args);
+        setup(app, {.token_length = 4});
+
+        const char *within[] = {"tool", "run", "-n", "abcd", nullptr};
+        app.parse(4, within);
+        CHECK(!cli::args::is_err());
+
+        const char *past[] = {"tool", "run", "-n", "abcde", nullptr};
+        app.parse(4, past);
+        CHECK_ERROR(LIMIT_EXCEEDED);
+        CHECK(cli::global_error.argv_pos == 3);
+    }
+
+    void total_bytes()
+    {
+        cli::app app("tool", "Does things", 1, no_args);
+        setup(app, {.total_bytes = 10});
+
+        // "run" + "a.c" + "b.c" + "d" is exactly 10 bytes
+        const char *within[] = {"tool", "run", "a.c", "b.c", "d", nullptr};
+        app.parse(5, within);
+        CHECK(!cli::args::is_err());
+
+        const char *past[] = {"tool", "run", "a.c", "b.c", "de", nullptr};
+        app.parse(5, past);
+        CHECK_ERROR(LIMIT_EXCEEDED);
+        CHECK(cli::global_error.argv_pos == 4);
+    }
+
+    void known_lengths()
+    {
+        cli::app app("tool", "Does things", 1, no_args);
+        setup(app, {.token_length = 4});
+
+        // Given lengths are trusted, so a long token may pass for a short one
+        const char *argv[] = {"tool", "run", "abcdefgh", nullptr};
+        const size_t short_lens[] = {4, 3, 4};
+        app.parse(3, argv, short_lens);
+        CHECK(!cli::args::is_err());
+
+        const size_t real_lens[] = {4, 3, 8};
+        app.parse(3, argv, real_lens);
+        CHECK_ERROR(LIMIT_EXCEEDED);
+        CHECK(cli::global_error.argv_pos == 2);
+    }
+
+    void bounded_scan()
+    {
+        cli::app app("tool", "Does things", 1, no_args);
+        setup(app, {.token_length = 4, .total_bytes = 8});
+
+        // Not null-terminated: scanning one byte past the limit must
+        // be enough to reject it, which ASan checks
+        const char unterminated[5] = {'a', 'b', 'c', 'd', 'e'};
+        const char *long_token[] = {"tool", "run", unterminated, nullptr};
+        app.parse(3, long_token);
+        CHECK_ERROR(LIMIT_EXCEEDED);
+        CHECK(cli::global_error.argv_pos == 2);
+
+        // The total bound tightens the scan once earlier tokens used most of it
+        const char tail[3] = {'x', 'y', 'z'};
+        const char *over_total[] = {"tool", "run", "abcd", tail, nullptr};
+        app.parse(4, over_total);
+        CHECK_ERROR(LIMIT_EXCEEDED);
+        CHECK(cli::global_error.argv_pos == 3);
+    }
+
+    void huge_input()
+    {
+        cli::app app("tool", "Does things", 1, no_args);
+        setup(app, {.tokens = 16, .token_length = 64});
+
+        const std::string huge(1 << 20, 'x');
+        const char *one_huge[] = {"tool", "run", huge.c_str(), nullptr};
+        app.parse(3, one_huge);
+        CHECK_ERROR(LIMIT_EXCEEDED);
+        CHECK(cli::global_error.argv_pos == 2);
+
+        std::vector<const char *> many(100000, "a");
+        many[0] = "tool";
+        many[1] = "run";
+        many.push_back(nullptr);
+        app.parse(static_cast<int>(many.size() - 1), many.data());
+        CHECK_ERROR(LIMIT_EXCEEDED);
+        CHECK(cli::global_error.argv_pos == 17);
+    }
+
+    void unlimited()
+    {
+        cli::app app("tool", "Does things", 1, no_args);
+        setup(app, {});
+
+        const std::string huge(1 << 16, 'x');
+        const char *argv[] = {"tool", "run", "-n", huge.c_str(), nullptr};
+        const auto args = app.parse(4, argv);
+        CHECK(!cli::args::is_err());
+    }
+}
+
+int main()
+{
+    tokens();
+    token_length();
+    total_bytes();
+    known_lengths();
+    bounded_scan();
+    huge_input();
+    unlimited();
+    return cli::test::result();
+}
@@ -0,0 +1,146 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/25/25.
+//
+
+#include <cstring>
+#include "check.h"
+#include "zelix/cli/multicall.h"
+
+using namespace zelix;
+
+namespace
+{
+    int ls_built = 0;
+    int cat_built = 0;
+
+    void add_tools(cli::multicall &tools)
+    {
+        tools.add("ls", "List directory contents", [](cli::app &ls)
+        {
+            ++ls_built;
+            ls.command("list", "l", "Lists", false);
+            ls.flag("all", "a", "Show hidden files", false);
+        });
+
+        tools.add("cat", "Concatenate files", [](cli::app &cat)
+        {
+            ++cat_built;
+            cat.command("show", "s", "Shows", false);
+        });
+    }
+
+    void dispatch_on_symlink()
+    {
+        ls_built = cat_built = 0;
+        const char *argv[] = {"/usr/bin/ls", "list", "-a", nullptr};
+        cli::multicall tools("box", 3, argv);
+        add_tools(tools);
+
+        cli::app *tool = tools.dispatch();
+        CHECK(tool != nullptr);
+        CHECK(strcmp(tool->name(), "ls") == 0);
+
+        // Only the selected tool is ever registered
+        CHECK(ls_built == 1);
+        CHECK(cat_built == 0);
+
+        auto args = tool->parse();
+        CHECK(!cli::args::is_err());
+        CHECK(args.flag<bool>("all"));
+    }
+
+    void dispatch_on_first_argument()
+    {
+        ls_built = cat_built = 0;
+        const char *argv[] = {"./box", "cat", "show", nullptr};
+        cli::multicall tools("box", 3, argv);
+        add_tools(tools);
+
+        cli::app *tool = tools.dispatch();
+        CHECK(tool != nullptr);
+        CHECK(strcmp(tool->name(), "cat") == 0);
+        CHECK(ls_built == 0);
+        CHECK(cat_built == 1);
+
+        // The tool only sees the arguments after its name
+        auto args = tool->parse();
+        CHECK(!cli::args::is_err());
+        CHECK_STR(args.get_cmd(), "show");
+    }
+
+    void unknown_tool()
+    {
+        ls_built = cat_built = 0;
+        const char *argv[] = {"box", "grep", nullptr};
+        cli::multicall tools("box", 2, argv);
+        add_tools(tools);
+
+        CHECK(tools.dispatch() == nullptr);
+        CHECK_ERROR(UNKNOWN_COMMAND);
+        CHECK(cli::global_error.argv_pos == 1);
+        CHECK_STR(cli::global_error.source, "grep");
+        CHECK(ls_built == 0 && cat_built == 0);
+
+        const auto help = tools.help<false>();
+        CHECK(strstr(help.c_str(), "grep") != nullptr);
+        CHECK(strstr(help.c_str(), "ls") != nullptr);
+        CHECK(strstr(help.c_str(), "Concatenate files") != nullptr);
+
+        const char *bare[] = {"box", nullptr};
+        cli::multicall empty("box", 1, bare);
+        add_tools(empty);
+        CHECK(empty.dispatch() == nullptr);
+        CHECK_ERROR(UNKNOWN_COMMAND);
+    }
+
+    void duplicate_tool()
+    {
+        const char *argv[] = {"box", nullptr};
+        cli::multicall tools("box", 1, argv);
+        add_tools(tools);
+        CHECK_THROWS(tools.add("ls", "Again", nullptr));
+    }
+
+    void basename()
+    {
+        CHECK_STR(cli::multicall::basename("ls"), "ls");
+        CHECK_STR(cli::multicall::basename("/usr/bin/ls"), "ls");
+        CHECK_STR(cli::multicall::basename("bin/"), "");
+        CHECK_STR(cli::multicall::basename("/"), "");
+    }
+}
+
+int main()
+{
+    dispatch_on_symlink();
+    dispatch_on_first_argument();
+    unknown_tool();
+    duplicate_tool();
+    basename();
+    return cli::test::result();
+}
@@ -0,0 +1,164 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/25/25.
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include "check.h"
+#include "zelix/cli/app.h"
+
+using namespace zelix;
+
+namespace
+{
+    const char *no_args[] = {"ld", nullptr};
+
+    class linker
+    {
+    public:
+        size_t link = 0;
+        size_t whole = 0;
+        size_t no_whole = 0;
+        size_t out = 0;
+        size_t jobs = 0;
+        size_t mode = 0;
+    };
+
+    linker setup(cli::app &app)
+    {
+        linker slots;
+        slots.link = app.command("link", "l", "Links", Celery::Str::External("exe"));
+        slots.whole = app.flag("whole-archive", "w", "Link every member", false);
+        slots.no_whole = app.flag("no-whole-archive", "W", "Stop linking every member", false);
+        slots.out = app.flag("out", "o", "Output", Celery::Str::External("a.out"));
+        slots.jobs = app.flag("jobs", "j", "Parallel jobs", 1, "LD_TEST_JOBS");
+        slots.mode = app.flag("mode", "m", "Mode", Celery::Str::External("fast"));
+        app.positional("first", "First input");
+        app.positional("second", "Second input");
+        app.positional("third", "Third input");
+        app.positional("rest", "Remaining inputs", true);
+        return slots;
+    }
+
+    void check_occurrence(
+        const cli::occurrence &occ,
+        const size_t slot,
+        const size_t argv_pos,
+        const char *text,
+        const bool positional
+    )
+    {
+        CHECK(occ.slot == slot);
+        CHECK(occ.argv_pos == argv_pos);
+        CHECK_STR(occ.text, text);
+        CHECK(occ.positional == positional);
+    }
+
+    void recorded_order()
+    {
+        // Sources other than argv never show up in the log
+        setenv("LD_TEST_JOBS", "4", 1);
+        FILE *file = fopen("occurrences.ini", "w");
+        fputs("mode = small\n", file);
+        fclose(file);
+
+        cli::app app("ld", "Links things", 1, no_args);
+        const auto slots = setup(app);
+        CHECK(app.config("occurrences.ini"));
+
+        const char *argv[] = {
+            "ld", "l", "shared", "a.o", "-w", "lib1.a", "--out=x.so",
+            "--no-whole-archive", "b.o", "-o", "y.so", "--whole-archive", "lib2.a", "c.o",
+            "--", "-w", "d.o", nullptr
+        };
+
+        auto args = app.parse(17, argv);
+        CHECK(!cli::args::is_err());
+        CHECK(args.flag<int>("jobs") == 4);
+        CHECK_STR(args.flag<Celery::Str::External>("mode"), "small");
+        CHECK_STR(args.flag<Celery::Str::External>("out"), "y.so");
+
+        const auto occs = args.occurrences();
+        CHECK(occs.size() == 11);
+        if (occs.size() != 11)
+        {
+            return;
+        }
+
+        check_occurrence(occs[0], slots.link, 1, "shared", false);
+        check_occurrence(occs[1], 0, 3, "a.o", true);
+        check_occurrence(occs[2], slots.whole, 4, "", false);
+        check_occurrence(occs[3], 1, 5, "lib1.a", true);
+        check_occurrence(occs[4], slots.out, 6, "x.so", false);
+        check_occurrence(occs[5], slots.no_whole, 7, "", false);
+        check_occurrence(occs[6], 2, 8, "b.o", true);
+        check_occurrence(occs[7], slots.out, 9, "y.so", false);
+        check_occurrence(occs[8], slots.whole, 11, "", false);
+        check_occurrence(occs[9], 3, 12, "lib2.a", true);
+        check_occurrence(occs[10], 3, 13, "c.o", true);
+
+        // Walked the way a linker would
+        bool linking_whole = false;
+        size_t whole_inputs = 0;
+        for (const auto &occ : occs)
+        {
+            if (occ.positional)
+            {
+                whole_inputs += linking_whole;
+            }
+            else if (occ.slot == slots.whole || occ.slot == slots.no_whole)
+            {
+                linking_whole = occ.slot == slots.whole;
+            }
+        }
+
+        CHECK(whole_inputs == 3);
+        unsetenv("LD_TEST_JOBS");
+    }
+
+    void cleared_between_parses()
+    {
+        cli::app app("ld", "Links things", 1, no_args);
+        setup(app);
+
+        const char *first[] = {"ld", "link", "exe", "-w", "a.o", "b.o", nullptr};
+        auto args = app.parse(6, first);
+        CHECK(args.occurrences().size() == 4);
+
+        const char *second[] = {"ld", "link", "exe", nullptr};
+        CHECK(args.parse(3, second));
+        CHECK(args.occurrences().size() == 1);
+    }
+}
+
+int main()
+{
+    recorded_order();
+    cleared_between_parses();
+    return cli::test::result();
+}
@@ -0,0 +1,111 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/25/25.
+//
+
+#include "check.h"
+#include "zelix/cli/app.h"
+
+using namespace zelix;
+
+namespace
+{
+    const char *no_args[] = {"tool", nullptr};
+
+    void setup(cli::app &app)
+    {
+        app.command("run", "r", "Runs", false);
+        app.flag("verbose", "v", "Verbose output", false);
+        app.flag("jobs", "j", "Parallel jobs", 1);
+    }
+
+    void stops_flag_parsing()
+    {
+        cli::app app("tool", "Does things", 1, no_args);
+        setup(app);
+
+        const char *argv[] = {"tool", "run", "-v", "--", "-j", "4", "--unknown", nullptr};
+        auto args = app.parse(7, argv);
+        CHECK(!cli::args::is_err());
+
+        // Flags after the terminator are left alone
+        CHECK(args.flag<bool>("verbose"));
+        CHECK(args.flag<int>("jobs") == 1);
+
+        const auto &rest = args.passthrough();
+        CHECK(rest.size() == 3);
+        CHECK(rest.argv_pos() == 4);
+        CHECK(rest.begin() == argv + 4); // Points into argv
+        CHECK_STR(rest[0], "-j");
+        CHECK_STR(rest[2], "--unknown");
+    }
+
+    void empty_passthrough()
+    {
+        cli::app app("tool", "Does things", 1, no_args);
+        setup(app);
+
+        const char *bare[] = {"tool", "run", "--", nullptr};
+        auto terminated = app.parse(3, bare);
+        CHECK(!cli::args::is_err());
+        CHECK(terminated.passthrough().empty());
+        CHECK(terminated.passthrough().size() == 0);
+
+        const char *argv[] = {"tool", "run", "-v", nullptr};
+        auto args = app.parse(3, argv);
+        CHECK(!cli::args::is_err());
+        CHECK(args.passthrough().empty());
+    }
+
+    void swallows_chain_delimiters()
+    {
+        const char *argv[] = {"tool", "run", "-j", "2", "+", "run", "--", "a", "+", "run", nullptr};
+        cli::app app("tool", "Does things", 10, argv);
+        setup(app);
+
+        // Delimiters after the terminator are passed through
+        auto chain = app.parse_chain();
+        CHECK(!cli::args::is_err());
+        CHECK(chain.size() == 2);
+        CHECK(chain[0].flag<int>("jobs") == 2);
+        CHECK(chain[0].passthrough().empty());
+
+        const auto &rest = chain[1].passthrough();
+        CHECK(rest.size() == 3);
+        CHECK_STR(rest[0], "a");
+        CHECK_STR(rest[1], "+");
+        CHECK_STR(rest[2], "run");
+    }
+}
+
+int main()
+{
+    stops_flag_parsing();
+    empty_passthrough();
+    swallows_chain_delimiters();
+    return cli::test::result();
+}
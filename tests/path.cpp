@@ -0,0 +1,168 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/25/25.
+//
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+#include "check.h"
+#include "zelix/cli/app.h"
+
+using namespace zelix;
+
+namespace
+{
+    const char *no_args[] = {"tool", nullptr};
+
+    void make_files()
+    {
+        FILE *file = fopen("path_file.txt", "w");
+        fputs("data\n", file);
+        fclose(file);
+        mkdir("path_dir", 0755);
+    }
+
+    Celery::Str::External ext(const char *str)
+    {
+        return Celery::Str::External(str);
+    }
+
+    void single_thread()
+    {
+        cli::path_batch batch;
+        batch.add(ext("path_file.txt"), cli::path_check::FILE, 1, Celery::Str::External());
+        batch.add(ext("path_dir"), cli::path_check::DIRECTORY, 2, Celery::Str::External());
+        batch.add(ext("path_dir"), cli::path_check::EXISTS, 3, Celery::Str::External());
+        CHECK(batch.run() == cli::path_batch::NONE);
+
+        batch.add(ext("path_dir"), cli::path_check::FILE, 4, Celery::Str::External());
+        batch.add(ext("path_file.txt"), cli::path_check::DIRECTORY, 5, Celery::Str::External());
+        const size_t failed = batch.run();
+        CHECK(failed == 3);
+        CHECK(batch.result(3) == cli::error::NOT_A_FILE);
+        CHECK(batch.result(4) == cli::error::NOT_A_DIRECTORY);
+    }
+
+    void many_threads()
+    {
+        // Enough jobs for several workers, with failures spread over them
+        const size_t count = cli::path_batch::JOBS_PER_THREAD * 5;
+        const std::vector<size_t> bad = {count - 1, 70, 33, 34};
+
+        cli::path_batch batch;
+        for (size_t i = 0; i < count; ++i)
+        {
+            batch.add(ext("path_file.txt"), cli::path_check::FILE, i, Celery::Str::External());
+        }
+
+        CHECK(batch.run() == cli::path_batch::NONE);
+
+        cli::path_batch failing;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const bool missing = std::find(bad.begin(), bad.end(), i) != bad.end();
+            failing.add(ext(missing ? "path_missing" : "path_file.txt"), cli::path_check::FILE, i, Celery::Str::External());
+        }
+
+        // The earliest failure wins, whichever thread found it first
+        for (int round = 0; round < 20; ++round)
+        {
+            const size_t failed = failing.run();
+            CHECK(failed == 33);
+            CHECK(failing.result(33) == cli::error::PATH_NOT_FOUND);
+            CHECK(failing.result(count - 1) == cli::error::PATH_NOT_FOUND);
+            CHECK(failing.result(32) == cli::error::UNKNOWN);
+        }
+    }
+
+    void replaced_jobs()
+    {
+        cli::path_batch batch;
+        const size_t job = batch.add(ext("path_missing"), cli::path_check::EXISTS, 2, Celery::Str::External());
+        batch.replace(job, ext("path_dir"), 4, ext("OUT"));
+
+        CHECK(batch.run() == cli::path_batch::NONE);
+        CHECK(batch.at(job).argv_pos == 4);
+        CHECK_STR(batch.at(job).origin, "OUT");
+
+        // Only the latest path is checked, and replacing keeps the check
+        batch.replace(job, ext("path_missing"), 6, Celery::Str::External());
+        CHECK(batch.run() == job);
+        CHECK(batch.result(job) == cli::error::PATH_NOT_FOUND);
+        CHECK(batch.at(job).argv_pos == 6);
+    }
+
+    void flag_given_twice()
+    {
+        cli::app app("tool", "Does things", 1, no_args);
+        app.command("run", "r", "Runs", false);
+        app.flag("out", "o", "Output directory", cli::path("."));
+        app.check_path("out", cli::path_check::DIRECTORY);
+
+        const char *fixed[] = {"tool", "run", "-o", "path_missing", "--out", "path_dir", nullptr};
+        app.parse(6, fixed);
+        CHECK(!cli::args::is_err());
+
+        const char *broken[] = {"tool", "run", "-o", "path_dir", "--out=path_file.txt", nullptr};
+        app.parse(5, broken);
+        CHECK_ERROR(NOT_A_DIRECTORY);
+        CHECK(cli::global_error.argv_pos == 4);
+    }
+
+    void many_positionals()
+    {
+        cli::app app("tool", "Does things", 1, no_args);
+        app.command("run", "r", "Runs", false);
+        app.positional("inputs", "Files", true);
+        app.check_path("inputs", cli::path_check::FILE);
+
+        std::vector<const char *> argv = {"tool", "run"};
+        for (size_t i = 0; i < 50; ++i)
+        {
+            argv.push_back(i == 40 || i == 20 ? "path_missing" : "path_file.txt");
+        }
+
+        argv.push_back(nullptr);
+        app.parse(static_cast<int>(argv.size() - 1), argv.data());
+        CHECK_ERROR(PATH_NOT_FOUND);
+        CHECK(cli::global_error.argv_pos == 22);
+    }
+}
+
+int main()
+{
+    make_files();
+    single_thread();
+    many_threads();
+    replaced_jobs();
+    flag_given_twice();
+    many_positionals();
+    return cli::test::result();
+}
@@ -0,0 +1,127 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/25/25.
+//
+
+#include "check.h"
+#include "zelix/cli/app.h"
+
+using namespace zelix;
+
+namespace
+{
+    const char *no_args[] = {"cc", nullptr};
+
+    void setup(cli::app &app)
+    {
+        app.command("build", "b", "Builds", false);
+        app.flag("verbose", "v", "Verbose output", false);
+        app.flag("jobs", "j", "Parallel jobs", 1);
+        app.positional("target", "What to build");
+        app.positional("inputs", "Files to compile", true);
+    }
+
+    void fills_in_order()
+    {
+        cli::app app("cc", "Compiles things", 1, no_args);
+        setup(app);
+        const char *argv[] = {"cc", "build", "lib", "a.c", "b.c", "c.c", nullptr};
+        const auto args = app.parse(6, argv);
+
+        CHECK(!cli::args::is_err());
+        CHECK(args.positional("target").size() == 1);
+        CHECK_STR(args.positional("target")[0], "lib");
+
+        const auto &inputs = args.positional("inputs");
+        CHECK(inputs.size() == 3);
+        CHECK(inputs.argv_pos() == 3);
+        CHECK(inputs.begin() == argv + 3); // Points into argv
+        CHECK_STR(inputs[2], "c.c");
+    }
+
+    void flags_around_variadic()
+    {
+        cli::app app("cc", "Compiles things", 1, no_args);
+        setup(app);
+        const char *before[] = {"cc", "build", "-v", "lib", "-j", "4", "a.c", "b.c", nullptr};
+        auto first = app.parse(8, before);
+
+        CHECK(!cli::args::is_err());
+        CHECK(first.positional("inputs").size() == 2);
+        CHECK(first.flag<int>("jobs") == 4);
+
+        const char *after[] = {"cc", "build", "lib", "a.c", "b.c", "-v", "--jobs=2", nullptr};
+        auto args = app.parse(7, after);
+
+        CHECK(!cli::args::is_err());
+        CHECK(args.positional("inputs").size() == 2);
+        CHECK(args.flag<bool>("verbose"));
+        CHECK(args.flag<int>("jobs") == 2);
+    }
+
+    void split_variadic_fails()
+    {
+        cli::app app("cc", "Compiles things", 1, no_args);
+        setup(app);
+        const char *argv[] = {"cc", "build", "lib", "a.c", "-j", "4", "b.c", nullptr};
+        app.parse(7, argv);
+
+        CHECK_ERROR(SPLIT_VARIADIC);
+        CHECK(cli::global_error.argv_pos == 6);
+        CHECK_STR(cli::global_error.source, "inputs");
+    }
+
+    void extra_argument_fails()
+    {
+        cli::app app("cc", "Compiles things", 1, no_args);
+        app.command("build", "b", "Builds", false);
+        app.positional("target", "What to build");
+
+        const char *argv[] = {"cc", "build", "lib", "extra", nullptr};
+        app.parse(4, argv);
+
+        CHECK_ERROR(NOT_EXPECTED_VALUE);
+        CHECK(cli::global_error.argv_pos == 3);
+    }
+
+    void only_last_variadic()
+    {
+        cli::app app("cc", "Compiles things", 1, no_args);
+        setup(app);
+        CHECK_THROWS(app.positional("more", "More files"));
+    }
+}
+
+int main()
+{
+    fills_in_order();
+    flags_around_variadic();
+    split_variadic_fails();
+    extra_argument_fails();
+    only_last_variadic();
+    return cli::test::result();
+}
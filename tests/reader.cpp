@@ -0,0 +1,208 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/25/25.
+//
+
+#include <vector>
+#include "check.h"
+#include "zelix/cli/app.h"
+
+using namespace zelix;
+
+namespace
+{
+    const char *no_args[] = {"cc", nullptr};
+
+    void setup(cli::app &app)
+    {
+        app.command("build", "b", "Builds", false);
+        app.flag("verbose", "v", "Verbose output", false);
+        app.flag("jobs", "j", "Parallel jobs", 1);
+        app.flag("name", "n", "Name", Celery::Str::External("out"));
+        app.positional("target", "What to build");
+        app.positional("inputs", "Files to compile", true);
+    }
+
+    std::vector<cli::event> read_all(cli::reader &reader)
+    {
+        std::vector<cli::event> events;
+        cli::event ev;
+        while (reader.next(ev))
+        {
+            events.push_back(ev);
+        }
+
+        return events;
+    }
+
+    void event_sequence()
+    {
+        cli::app app("cc", "Compiles things", 1, no_args);
+        setup(app);
+
+        const char *argv[] = {"cc", "build", "-v", "-j", "4", "--name=x", "lib", "a.c", "b.c", "--", "rest", nullptr};
+        auto reader = app.events(11, argv);
+        const auto events = read_all(reader);
+        CHECK(reader.finished());
+        CHECK(!cli::args::is_err());
+
+        const cli::event::type expected[] = {
+            cli::event::COMMAND,
+            cli::event::FLAG,
+            cli::event::FLAG,
+            cli::event::VALUE,
+            cli::event::FLAG,
+            cli::event::VALUE,
+            cli::event::POSITIONAL,
+            cli::event::POSITIONAL,
+            cli::event::POSITIONAL,
+            cli::event::PASSTHROUGH,
+        };
+
+        CHECK(events.size() == std::size(expected));
+        if (events.size() != std::size(expected))
+        {
+            return;
+        }
+
+        for (size_t i = 0; i < events.size(); ++i)
+        {
+            CHECK(events[i].event_type == expected[i]);
+        }
+
+        CHECK_STR(events[0].name, "build");
+        CHECK(events[0].command);
+        CHECK_STR(events[1].name, "verbose");
+        CHECK(events[1].argv_pos == 2);
+
+        CHECK_STR(events[3].name, "jobs");
+        CHECK_STR(events[3].text, "4");
+        CHECK(events[3].text.Ptr() == argv[4]); // Slices point into argv
+        CHECK(events[3].argv_pos == 4);
+
+        // Inline values are sliced out of the flag's own token
+        CHECK_STR(events[5].text, "x");
+        CHECK(events[5].argv_pos == 5);
+
+        CHECK_STR(events[6].name, "target");
+        CHECK(events[6].slot == 0);
+        CHECK_STR(events[8].name, "inputs");
+        CHECK(events[8].slot == 1);
+        CHECK_STR(events[8].text, "b.c");
+
+        CHECK(events[9].rest.size() == 1);
+        CHECK_STR(events[9].rest[0], "rest");
+    }
+
+    void default_event()
+    {
+        cli::app app("cc", "Compiles things", 1, no_args);
+        setup(app);
+
+        // A value missing at the very end falls back to the default
+        const char *argv[] = {"cc", "build", "-j", nullptr};
+        auto reader = app.events(3, argv);
+        const auto events = read_all(reader);
+
+        CHECK(events.size() == 3);
+        CHECK(events.size() == 3 && events[2].event_type == cli::event::DEFAULT);
+        CHECK(events.size() == 3 && events[2].slot == events[1].slot);
+    }
+
+    void error_event_is_last()
+    {
+        cli::app app("cc", "Compiles things", 1, no_args);
+        setup(app);
+
+        const char *argv[] = {"cc", "build", "--nope", "lib", nullptr};
+        auto reader = app.events(4, argv);
+        const auto events = read_all(reader);
+
+        CHECK(reader.finished());
+        CHECK(events.size() == 2);
+        CHECK(events.back().event_type == cli::event::ERROR);
+        CHECK(events.back().error_type == cli::error::UNKNOWN_FLAG);
+        CHECK(events.back().argv_pos == 2);
+
+        cli::event ev;
+        CHECK(!reader.next(ev)); // Nothing follows an error
+
+        const char *unknown[] = {"cc", "install", nullptr};
+        auto other = app.events(2, unknown);
+        CHECK(other.next(ev));
+        CHECK(ev.event_type == cli::event::ERROR && ev.error_type == cli::error::UNKNOWN_COMMAND);
+    }
+
+    void checkpoint_restore()
+    {
+        cli::app app("cc", "Compiles things", 1, no_args);
+        setup(app);
+
+        const char *argv[] = {"cc", "build", "-v", "-j", "4", "lib", "a.c", nullptr};
+        auto reader = app.events(7, argv);
+
+        // Stop right after "-j", while it is waiting for its value
+        cli::event ev;
+        cli::event jobs;
+        for (int i = 0; i < 3; ++i)
+        {
+            CHECK(reader.next(ev));
+        }
+
+        jobs = ev;
+        CHECK(reader.between_tokens());
+        const auto point = reader.save();
+        const auto rest = read_all(reader);
+        CHECK(rest.size() == 3);
+
+        // Resuming over an edited tail only reads the new tokens
+        const char *edited[] = {"cc", "build", "-v", "-j", "8", "lib", "x.c", "y.c", nullptr};
+        auto resumed = app.events(8, edited);
+        resumed.restore(point, jobs);
+        const auto events = read_all(resumed);
+
+        CHECK(events.size() == 4);
+        if (events.size() == 4)
+        {
+            CHECK(events[0].event_type == cli::event::VALUE);
+            CHECK_STR(events[0].name, "jobs");
+            CHECK_STR(events[0].text, "8");
+            CHECK(events[1].event_type == cli::event::POSITIONAL && events[1].slot == 0);
+            CHECK_STR(events[3].text, "y.c");
+            CHECK(events[3].slot == 1);
+        }
+    }
+}
+
+int main()
+{
+    event_sequence();
+    default_event();
+    error_event_is_last();
+    checkpoint_restore();
+    return cli::test::result();
+}
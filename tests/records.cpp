@@ -0,0 +1,183 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/25/25.
+//
+
+#include <cstdio>
+#include <unistd.h>
+#include "check.h"
+#include "zelix/cli/records.h"
+
+using namespace zelix;
+
+namespace
+{
+    void empty_arguments_kept()
+    {
+        // prog "" x
+        static const char data[] = "prog\0\0x";
+        cli::records rec;
+        rec.assign(data, sizeof(data)); // Includes the final terminator
+
+        CHECK(rec.next());
+        CHECK(rec.argc() == 3);
+        CHECK(rec.lens()[1] == 0);
+        CHECK(rec.lens()[2] == 1 && rec.argv()[2][0] == 'x');
+        CHECK(rec.argv()[3] == nullptr);
+        CHECK(!rec.next());
+    }
+
+    void unterminated_last_record()
+    {
+        static const char data[] = "prog\0-v\0a.c";
+        cli::records rec;
+        rec.assign(data, sizeof(data) - 1);
+
+        CHECK(rec.next());
+        CHECK(rec.argc() == 3);
+        CHECK(rec.lens()[2] == 3);
+    }
+
+    void counted()
+    {
+        static const char data[] = "2\0prog\0\0" "3\0prog\0-v\0a.c\0" "0\0";
+        cli::records rec;
+        rec.set_framing(cli::records::COUNTED);
+        rec.assign(data, sizeof(data) - 1);
+
+        CHECK(rec.next());
+        CHECK(rec.argc() == 2);
+        CHECK(rec.lens()[1] == 0);
+
+        CHECK(rec.next());
+        CHECK(rec.argc() == 3);
+
+        CHECK(rec.next());
+        CHECK(rec.argc() == 0);
+
+        CHECK(!rec.next());
+        CHECK(!rec.malformed());
+    }
+
+    void counted_malformed()
+    {
+        static const char bad_count[] = "two\0prog\0";
+        cli::records rec;
+        rec.set_framing(cli::records::COUNTED);
+        rec.assign(bad_count, sizeof(bad_count) - 1);
+        CHECK(!rec.next());
+        CHECK(rec.malformed());
+
+        static const char truncated[] = "3\0prog\0-v\0";
+        rec.assign(truncated, sizeof(truncated) - 1);
+        CHECK(!rec.malformed()); // Reset by the new input
+        CHECK(!rec.next());
+        CHECK(rec.malformed());
+        CHECK(rec.argc() == 0);
+    }
+
+    void empty_record_framing()
+    {
+        static const char data[] = "prog\0a\0\0prog\0b\0c\0\0";
+        cli::records rec;
+        rec.set_framing(cli::records::EMPTY_RECORD);
+        rec.assign(data, sizeof(data) - 1);
+
+        CHECK(rec.next());
+        CHECK(rec.argc() == 2);
+        CHECK(rec.next());
+        CHECK(rec.argc() == 3);
+        CHECK(!rec.next());
+    }
+
+    void program_name()
+    {
+        static const char data[] = "a\0\0b\0";
+        cli::records rec;
+        rec.set_program("xargs");
+        rec.assign(data, sizeof(data) - 1);
+
+        CHECK(rec.next());
+        CHECK(rec.argc() == 4);
+        CHECK(rec.lens()[0] == 5);
+        CHECK(rec.lens()[2] == 0);
+    }
+
+    void from_pipe()
+    {
+        int fds[2];
+        CHECK(pipe(fds) == 0);
+
+        static const char data[] = "prog\0\0x";
+        CHECK(write(fds[1], data, sizeof(data) - 1) == sizeof(data) - 1);
+        close(fds[1]);
+
+        cli::records rec;
+        CHECK(rec.read(fds[0]));
+        close(fds[0]);
+
+        CHECK(rec.next());
+        CHECK(rec.argc() == 3);
+        CHECK(rec.lens()[2] == 1);
+
+        // Nothing at all is no invocation, rather than an empty one
+        CHECK(pipe(fds) == 0);
+        close(fds[1]);
+        CHECK(rec.read(fds[0]));
+        close(fds[0]);
+        CHECK(!rec.next());
+    }
+
+    void from_file()
+    {
+        static const char data[] = "1\0prog\0" "2\0prog\0x\0";
+        FILE *file = fopen("records.bin", "wb");
+        fwrite(data, 1, sizeof(data) - 1, file);
+        fclose(file);
+
+        cli::records rec;
+        rec.set_framing(cli::records::COUNTED);
+        CHECK(rec.map("records.bin"));
+
+        CHECK(rec.next() && rec.argc() == 1);
+        CHECK(rec.next() && rec.argc() == 2);
+        CHECK(!rec.next());
+    }
+}
+
+int main()
+{
+    empty_arguments_kept();
+    unterminated_last_record();
+    counted();
+    counted_malformed();
+    empty_record_framing();
+    program_name();
+    from_pipe();
+    from_file();
+    return cli::test::result();
+}
@@ -0,0 +1,165 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/25/25.
+//
+
+#include <string>
+#include <vector>
+#include "check.h"
+#include "zelix/cli/app.h"
+
+using namespace zelix;
+
+namespace
+{
+    const char *no_args[] = {"tool", nullptr};
+
+    /**
+     * @brief An edited command line, owning its tokens like an editor's buffer would.
+     */
+    class line
+    {
+        std::vector<std::string> tokens;
+        std::vector<const char *> ptrs;
+
+    public:
+        explicit line(const std::vector<const char *> &args)
+        {
+            for (const char *arg : args)
+            {
+                tokens.emplace_back(arg);
+            }
+
+            for (const auto &token : tokens)
+            {
+                ptrs.push_back(token.c_str());
+            }
+
+            ptrs.push_back(nullptr);
+        }
+
+        [[nodiscard]] int argc() const
+        {
+            return static_cast<int>(tokens.size());
+        }
+
+        const char **argv()
+        {
+            return ptrs.data();
+        }
+    };
+
+    void lazily_loaded_command()
+    {
+        cli::app app("tool", "Does things", 1, no_args);
+        app.flag("verbose", "v", "Verbose output", false);
+        app.flag("jobs", "j", "Parallel jobs", 1);
+        app.command("build", "b", "Builds", false, [](cli::app &build)
+        {
+            // Enough flags to make the flag table grow and move
+            build.flag("release", "r", "Optimized build", false);
+            build.flag("target", "t", "Target triple", Celery::Str::External("native"));
+            build.flag("level", "O", "Optimization level", 0);
+            for (const char *name : {"a1", "a2", "a3", "a4", "a5", "a6", "a7", "a8", "a9"})
+            {
+                build.flag(name, name, "Filler", false);
+            }
+        });
+        app.command("test", "T", "Tests", false);
+
+        // The command's flags are registered during the first, journaled parse
+        auto args = app.parse(1, no_args);
+        auto first = line({"tool", "-v", "-j", "4", "build", "-O", "2"});
+        CHECK(app.reparse(args, first.argc(), first.argv()));
+
+        // The next ones replay the tokens before the edit
+
+        auto edited = line({"tool", "-v", "-j", "4", "build", "-O", "3", "-r"});
+        CHECK(app.reparse(args, edited.argc(), edited.argv()));
+        CHECK(args.flag<bool>("verbose"));
+        CHECK(args.flag<int>("jobs") == 4);
+        CHECK_STR(args.get_cmd(), "build");
+        CHECK(args.flag<int>("level") == 3);
+        CHECK(args.flag<bool>("release"));
+
+        auto retarget = line({"tool", "-v", "-j", "4", "build", "-t", "arm"});
+        CHECK(app.reparse(args, retarget.argc(), retarget.argv()));
+        CHECK_STR(args.flag<Celery::Str::External>("target"), "arm");
+        CHECK(args.flag<int>("level") == 0);
+        CHECK(args.flag<int>("jobs") == 4);
+    }
+
+    void matches_full_parse()
+    {
+        cli::app app("tool", "Does things", 1, no_args);
+        app.flag("verbose", "v", "Verbose output", false);
+        app.flag("jobs", "j", "Parallel jobs", 1);
+        app.command("build", "b", "Builds", Celery::Str::External("all"));
+        app.positional("inputs", "Files", true);
+
+        auto incremental = app.parse(1, no_args);
+        const std::vector<std::vector<const char *>> edits = {
+            {"tool", "build"},
+            {"tool", "build", "lib"},
+            {"tool", "build", "lib", "-j"},
+            {"tool", "build", "lib", "-j", "8"},
+            {"tool", "build", "lib", "-j", "8", "a.c"},
+            {"tool", "build", "lib", "-j", "x", "a.c"},
+            {"tool", "build", "lib", "-j", "9", "a.c", "b.c"},
+            {"tool", "-v", "build", "lib", "-j", "9", "a.c", "b.c"},
+            {"tool", "-v", "build", "lib", "--", "a.c"},
+        };
+
+        for (const auto &edit : edits)
+        {
+            auto typed = line(edit);
+            const bool ok = app.reparse(incremental, typed.argc(), typed.argv());
+            const auto incremental_error = cli::global_error;
+
+            auto fresh = app.parse(typed.argc(), typed.argv());
+            CHECK(ok == !cli::args::is_err());
+            CHECK(incremental_error.error_type == cli::global_error.error_type);
+            CHECK(incremental_error.argv_pos == cli::global_error.argv_pos);
+
+            if (ok)
+            {
+                CHECK(incremental.flag<int>("jobs") == fresh.flag<int>("jobs"));
+                CHECK(incremental.flag<bool>("verbose") == fresh.flag<bool>("verbose"));
+                CHECK(incremental.positional("inputs").size() == fresh.positional("inputs").size());
+                CHECK(incremental.passthrough().size() == fresh.passthrough().size());
+                CHECK(incremental.occurrences().size() == fresh.occurrences().size());
+            }
+        }
+    }
+}
+
+int main()
+{
+    lazily_loaded_command();
+    matches_full_parse();
+    return cli::test::result();
+}
@@ -0,0 +1,277 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/25/25.
+//
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "check.h"
+#include "zelix/cli/app.h"
+
+using namespace zelix;
+
+namespace
+{
+    const char *no_args[] = {"tool", nullptr};
+    const cli::choice_set modes({"debug", "release"});
+    const cli::choice_set other_modes({"debug", "fast"});
+
+    void setup(cli::app &app, const cli::choice_set &set = modes)
+    {
+        app.command("build", "b", "Builds", Celery::Str::External("all"));
+        app.flag("jobs", "j", "Parallel jobs", 1);
+        app.flag("ratio", "r", "Ratio", 1.0f);
+        app.flag("verbose", "v", "Verbose output", false);
+        app.flag("name", "n", "Name", Celery::Str::External("none"));
+        app.flag("mode", "m", "Build mode", cli::choice(set, 0));
+        app.positional("inputs", "Files", true);
+    }
+
+    const char *argv[] = {
+        "tool", "build", "lib", "-j", "4", "-r", "0.5", "-v", "-m", "release",
+        "a.c", "b.c", "--", "x", "y", nullptr
+    };
+
+    void round_trip()
+    {
+        cli::app app("tool", "Does things", 1, no_args);
+        setup(app);
+
+        auto args = app.parse(15, argv);
+        CHECK(!cli::args::is_err());
+        const auto bytes = args.serialize();
+
+        const auto view = app.from_bytes(bytes.data(), bytes.size());
+        CHECK_STR(view.get_cmd(), "build");
+        CHECK(view.get_cmd().Ptr() == args.get_cmd().Ptr()); // The registered pointer
+        CHECK_STR(view.command<Celery::Str::External>("build"), "lib");
+        CHECK(view.flag<int>("jobs") == 4);
+        CHECK(view.flag<float>("ratio") == 0.5f);
+        CHECK(view.flag<bool>("verbose"));
+        CHECK_STR(view.flag<Celery::Str::External>("name"), "none"); // Default
+        CHECK(view.flag<cli::choice>("mode").id() == 1);
+
+        const auto inputs = view.positional("inputs");
+        CHECK(inputs.size() == 2);
+        CHECK_STR(inputs[1], "b.c");
+
+        const auto rest = view.passthrough();
+        CHECK(rest.size() == 2);
+        CHECK_STR(rest[0], "x");
+    }
+
+    void lazy_round_trip()
+    {
+        cli::app app("tool", "Does things", 1, no_args);
+        setup(app);
+
+        auto args = app.parse<true>(15, argv);
+        const auto bytes = args.serialize();
+
+        const auto view = app.from_bytes(bytes.data(), bytes.size());
+        CHECK(view.flag<int>("jobs") == 4);
+        CHECK(view.flag<cli::choice>("mode").id() == 1);
+    }
+
+    void bound_flags()
+    {
+        int jobs = 0;
+        cli::app app("tool", "Does things", 1, no_args);
+        app.command("build", "b", "Builds", false);
+        app.flag("jobs", "j", "Parallel jobs", 1, &jobs);
+
+        const char *given[] = {"tool", "build", "-j", "6", nullptr};
+        auto args = app.parse(4, given);
+        CHECK(jobs == 6);
+
+        const auto bytes = args.serialize();
+        const auto view = app.from_bytes(bytes.data(), bytes.size());
+        CHECK(view.flag<int>("jobs") == 6);
+    }
+
+    void schema_mismatch()
+    {
+        cli::app app("tool", "Does things", 1, no_args);
+        setup(app);
+        auto args = app.parse(15, argv);
+        const auto bytes = args.serialize();
+
+        // Same names and types, other options
+        cli::app other("tool", "Does things", 1, no_args);
+        setup(other, other_modes);
+        CHECK_THROWS(other.from_bytes(bytes.data(), bytes.size()));
+
+        cli::app fewer("tool", "Does things", 1, no_args);
+        fewer.command("build", "b", "Builds", Celery::Str::External("all"));
+        CHECK_THROWS(fewer.from_bytes(bytes.data(), bytes.size()));
+    }
+
+    /**
+     * @brief Corrupts a copy of a valid buffer, which must then be rejected.
+     */
+    template <typename F>
+    void check_corrupt(cli::app &app, const std::vector<unsigned char> &bytes, F corrupt)
+    {
+        std::vector<unsigned char> copy = bytes;
+        cli::blob::header head;
+        memcpy(&head, copy.data(), sizeof(head));
+
+        unsigned char *cursor = copy.data() + sizeof(head);
+        auto *slot_index = reinterpret_cast<uint32_t *>(cursor);
+        cursor += head.slot_count * sizeof(uint32_t);
+        auto *entries = reinterpret_cast<cli::blob::entry *>(cursor);
+        cursor += head.entry_count * sizeof(cli::blob::entry);
+        auto *lists = reinterpret_cast<cli::blob::list *>(cursor);
+        cursor += head.list_count * sizeof(cli::blob::list);
+        auto *strings = reinterpret_cast<cli::blob::string_ref *>(cursor);
+
+        corrupt(head, slot_index, entries, lists, strings);
+        memcpy(copy.data(), &head, sizeof(head));
+        CHECK_THROWS(app.from_bytes(copy.data(), copy.size()));
+    }
+
+    void corrupt_buffers()
+    {
+        cli::app app("tool", "Does things", 1, no_args);
+        setup(app);
+        auto args = app.parse(15, argv);
+        const auto bytes = args.serialize();
+
+        // Sanity check: the unmodified copy loads
+        std::vector<unsigned char> copy = bytes;
+        CHECK(app.from_bytes(copy.data(), copy.size()).flag<int>("jobs") == 4);
+
+        CHECK_THROWS(app.from_bytes(bytes.data(), sizeof(cli::blob::header) - 1));
+        CHECK_THROWS(app.from_bytes(bytes.data(), bytes.size() - 1));
+
+        using head_t = cli::blob::header;
+        using entry_t = cli::blob::entry;
+        using list_t = cli::blob::list;
+        using string_t = cli::blob::string_ref;
+
+        check_corrupt(app, bytes, [](head_t &head, uint32_t *, entry_t *, list_t *, string_t *)
+        {
+            head.magic = 0;
+        });
+
+        check_corrupt(app, bytes, [](head_t &head, uint32_t *slot_index, entry_t *, list_t *, string_t *)
+        {
+            slot_index[0] = head.entry_count;
+        });
+
+        check_corrupt(app, bytes, [](head_t &head, uint32_t *, entry_t *entries, list_t *, string_t *)
+        {
+            // The command's value is a string
+            entries[0].payload = head.string_count;
+        });
+
+        check_corrupt(app, bytes, [](head_t &, uint32_t *, entry_t *entries, list_t *, string_t *)
+        {
+            entries[0].type = 200;
+        });
+
+        check_corrupt(app, bytes, [](head_t &head, uint32_t *, entry_t *, list_t *lists, string_t *)
+        {
+            lists[0].count = head.string_count;
+        });
+
+        check_corrupt(app, bytes, [](head_t &, uint32_t *, entry_t *, list_t *lists, string_t *)
+        {
+            lists[1].first = UINT32_MAX;
+        });
+
+        check_corrupt(app, bytes, [](head_t &head, uint32_t *, entry_t *, list_t *, string_t *strings)
+        {
+            strings[0].offset = head.pool_size;
+        });
+
+        check_corrupt(app, bytes, [](head_t &, uint32_t *, entry_t *, list_t *, string_t *strings)
+        {
+            strings[0].size += 1; // Past its terminator
+        });
+
+        check_corrupt(app, bytes, [](head_t &head, uint32_t *, entry_t *, list_t *, string_t *)
+        {
+            head.cmd_slot = 1000;
+        });
+
+        check_corrupt(app, bytes, [](head_t &head, uint32_t *, entry_t *, list_t *, string_t *)
+        {
+            head.pool_size = UINT32_MAX;
+        });
+    }
+
+    void setup_registrars(cli::app &app)
+    {
+        app.command("build", "b", "Builds", false, [](cli::app &build)
+        {
+            build.flag("opt", "O", "Optimization level", 0);
+        });
+
+        app.command("test", "t", "Tests", false, [](cli::app &test)
+        {
+            test.flag("filter", "f", "Test filter", Celery::Str::External("*"));
+        });
+
+        app.flag("jobs", "j", "Parallel jobs", 1);
+    }
+
+    void lazily_loaded_command()
+    {
+        cli::app producer("tool", "Does things", 1, no_args);
+        setup_registrars(producer);
+
+        const char *build[] = {"tool", "build", "-O", "2", "-j", "3", nullptr};
+        auto args = producer.parse(6, build);
+        CHECK(!cli::args::is_err());
+        const auto bytes = args.serialize();
+
+        // The worker never selected "build", the buffer tells it to load it
+        cli::app worker("tool", "Does things", 1, no_args);
+        setup_registrars(worker);
+
+        const auto view = worker.from_bytes(bytes.data(), bytes.size());
+        CHECK_STR(view.get_cmd(), "build");
+        CHECK(view.flag<int>("opt") == 2);
+        CHECK(view.flag<int>("jobs") == 3);
+
+        // Loading is idempotent
+        CHECK(worker.from_bytes(bytes.data(), bytes.size()).flag<int>("opt") == 2);
+    }
+}
+
+int main()
+{
+    round_trip();
+    lazy_round_trip();
+    bound_flags();
+    schema_mismatch();
+    corrupt_buffers();
+    lazily_loaded_command();
+    return cli::test::result();
+}
@@ -0,0 +1,262 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/25/25.
+//
+
+#include <string>
+#include <vector>
+#include "check.h"
+#include "zelix/cli/tokenizer.h"
+
+using namespace zelix;
+
+namespace
+{
+    /**
+     * @brief Splits a copy of the line.
+     * @return Whether it could be split.
+     */
+    bool split(const std::string &line, std::vector<std::string> &out)
+    {
+        std::vector<char> buf(line.begin(), line.end());
+        buf.push_back('\0');
+
+        const char *argv[64];
+        size_t lens[64];
+        const int argc = cli::tokenizer::split(buf.data(), line.size(), argv, lens, 64);
+
+        out.clear();
+        for (int i = 0; i < argc; ++i)
+        {
+            CHECK(strlen(argv[i]) == lens[i]); // Terminated in place
+            out.emplace_back(argv[i], lens[i]);
+        }
+
+        return argc >= 0;
+    }
+
+    /**
+     * @brief Byte-at-a-time version of the same rules, to check the SSE2 scans against.
+     */
+    bool reference(const std::string &line, std::vector<std::string> &out)
+    {
+        out.clear();
+        size_t i = 0;
+        const auto space = [](const char c)
+        {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+        };
+
+        while (true)
+        {
+            while (i < line.size() && space(line[i]))
+            {
+                ++i;
+            }
+
+            if (i >= line.size())
+            {
+                return true;
+            }
+
+            std::string arg;
+            while (i < line.size() && !space(line[i]))
+            {
+                const char c = line[i++];
+                if (c == '\\')
+                {
+                    if (i >= line.size())
+                    {
+                        return false;
+                    }
+
+                    if (line[i] != '\n')
+                    {
+                        arg += line[i];
+                    }
+
+                    ++i;
+                }
+                else if (c == '\'')
+                {
+                    const size_t end = line.find('\'', i);
+                    if (end == std::string::npos)
+                    {
+                        return false;
+                    }
+
+                    arg += line.substr(i, end - i);
+                    i = end + 1;
+                }
+                else if (c == '"')
+                {
+                    while (true)
+                    {
+                        if (i >= line.size())
+                        {
+                            return false;
+                        }
+
+                        const char q = line[i];
+                        if (q == '"')
+                        {
+                            ++i;
+                            break;
+                        }
+
+                        const char next = i + 1 < line.size() ? line[i + 1] : '\0';
+                        if (q == '\\' && (next == '"' || next == '\\'))
+                        {
+                            arg += next;
+                            i += 2;
+                        }
+                        else if (q == '\\' && next == '\n')
+                        {
+                            i += 2;
+                        }
+                        else
+                        {
+                            arg += q;
+                            ++i;
+                        }
+                    }
+                }
+                else
+                {
+                    arg += c;
+                }
+            }
+
+            out.push_back(arg);
+        }
+    }
+
+    void quoting_rules()
+    {
+        std::vector<std::string> out;
+        CHECK(split("  build  'a b' \"c \\\"d\\\" \\\\ e\"  f\\ g h\\\ni  ", out));
+        CHECK(out.size() == 5);
+        CHECK(out.size() == 5 && out[0] == "build");
+        CHECK(out.size() == 5 && out[1] == "a b");
+        CHECK(out.size() == 5 && out[2] == "c \"d\" \\ e");
+        CHECK(out.size() == 5 && out[3] == "f g");
+        CHECK(out.size() == 5 && out[4] == "hi"); // Line continuation
+
+        // Escapes other than \" and \\ are kept inside double quotes
+        CHECK(split("\"a\\nb\" ''", out));
+        CHECK(out.size() == 2 && out[0] == "a\\nb" && out[1].empty());
+    }
+
+    void long_arguments()
+    {
+        // Past 16 bytes, so the specials are found by the SSE2 scans
+        const std::string line =
+            "--output=/very/long/path/to/some/file.txt "
+            "\"a double quoted argument with \\\"escapes\\\" past sixteen\" "
+            "'a single quoted argument that is also quite long' "
+            "unquoted_argument_that_is_long\\ with\\ escaped\\ spaces";
+
+        std::vector<std::string> out;
+        CHECK(split(line, out));
+        CHECK(out.size() == 4);
+        CHECK(out.size() == 4 && out[0] == "--output=/very/long/path/to/some/file.txt");
+        CHECK(out.size() == 4 && out[1] == "a double quoted argument with \"escapes\" past sixteen");
+        CHECK(out.size() == 4 && out[2] == "a single quoted argument that is also quite long");
+        CHECK(out.size() == 4 && out[3] == "unquoted_argument_that_is_long with escaped spaces");
+    }
+
+    void matches_reference()
+    {
+        // Every special byte at every offset of a 40-byte line
+        const char specials[] = {' ', '\t', '\n', '\'', '"', '\\'};
+        for (const char first : specials)
+        {
+            for (const char second : specials)
+            {
+                for (size_t pos = 0; pos < 40; ++pos)
+                {
+                    std::string line(40, 'x');
+                    line[pos] = first;
+                    line[(pos * 7 + 3) % 40] = second;
+
+                    std::vector<std::string> expected;
+                    std::vector<std::string> actual;
+                    const bool ok = reference(line, expected);
+                    CHECK(split(line, actual) == ok);
+                    if (ok)
+                    {
+                        CHECK(actual == expected);
+                    }
+                }
+            }
+        }
+    }
+
+    void errors()
+    {
+        std::vector<std::string> out;
+
+        CHECK(!split("run 'unterminated", out));
+        CHECK_ERROR(UNTERMINATED_QUOTE);
+
+        CHECK(!split("run \"unterminated \\\"", out));
+        CHECK_ERROR(UNTERMINATED_QUOTE);
+
+        // A lone trailing backslash has nothing to escape
+        CHECK(!split("run arg\\", out));
+        CHECK_ERROR(UNTERMINATED_ESCAPE);
+        CHECK(cli::global_error.offset == 7);
+
+        std::vector<char> buf(128, 'a');
+        for (size_t i = 1; i < buf.size(); i += 2)
+        {
+            buf[i] = ' ';
+        }
+
+        const char *argv[4];
+        CHECK(cli::tokenizer::split(buf.data(), buf.size() - 1, argv, nullptr, 4) == -1);
+        CHECK_ERROR(TOO_MANY_ARGUMENTS);
+    }
+
+    void null_terminated()
+    {
+        char buf[] = "a b";
+        const char *argv[3] = {"x", "x", "x"};
+        CHECK(cli::tokenizer::split(buf, 3, argv, nullptr, 3) == 2);
+        CHECK(argv[2] == nullptr);
+    }
+}
+
+int main()
+{
+    quoting_rules();
+    long_arguments();
+    matches_reference();
+    errors();
+    null_terminated();
+    return cli::test::result();
+}
@@ -0,0 +1,149 @@
+/*
+        ==== The Zelix Programming Language ====
+---------------------------------------------------------
+  - This file is part of the Fluent Programming Language
+    codebase. Fluent is a fast, statically-typed and
+    memory-safe programming language that aims to
+    match native speeds while staying highly performant.
+---------------------------------------------------------
+  - Fluent is categorized as free software; you can
+    redistribute it and/or modify it under the terms of
+    the GNU General Public License as published by the
+    Free Software Foundation, either version 3 of the
+    License, or (at your option) any later version.
+---------------------------------------------------------
+  - Fluent is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE. See the GNU General Public
+    License for more details.
+---------------------------------------------------------
+  - You should have received a copy of the GNU General
+    Public License along with Fluent. If not, see
+    <https://www.gnu.org/licenses/>.
+*/
+
+//
+// Created by rodrigo on 8/25/25.
+//
+
+#include <string>
+#include "check.h"
+#include "zelix/cli/app.h"
+#include "zelix/cli/utf8.h"
+
+using namespace zelix;
+
+namespace
+{
+    const char *no_args[] = {"tool", nullptr};
+
+    /**
+     * @brief Validates `text` at offset 0 and again past a run of ASCII.
+     *
+     * The padding makes the SIMD loop skip 16-byte chunks before
+     * reaching the sequence, and the tail keeps it from being the
+     * last bytes.
+     *
+     * @param expected Offset of the first invalid byte within `text`, or `NONE`.
+     */
+    void check(const std::string &text, const size_t expected, const bool control = false)
+    {
+        CHECK(cli::utf8::validate(text.data(), text.size(), control) == expected);
+
+        for (const size_t padding : {17, 32, 45})
+        {
+            const std::string padded = std::string(padding, 'a') + text + std::string(20, 'b');
+            const size_t offset = cli::utf8::validate(padded.data(), padded.size(), control);
+            CHECK(offset == (expected == cli::utf8::NONE ? cli::utf8::NONE : padding + expected));
+        }
+    }
+
+    void valid()
+    {
+        check("", cli::utf8::NONE);
+        check("plain ascii", cli::utf8::NONE);
+        check("\xC3\xA9t\xC3\xA9", cli::utf8::NONE); // été
+        check("\xE2\x82\xAC", cli::utf8::NONE); // U+20AC
+        check("\xF0\x9F\x98\x80", cli::utf8::NONE); // U+1F600
+        check("\xF4\x8F\xBF\xBF", cli::utf8::NONE); // U+10FFFF
+        check("\xED\x9F\xBF", cli::utf8::NONE); // U+D7FF, right before the surrogates
+        check("\xEE\x80\x80", cli::utf8::NONE); // U+E000, right after them
+    }
+
+    void overlongs()
+    {
+        check("\xC0\xAF", 0);
+        check("\xC1\xBF", 0);
+        check("x\xE0\x80\xAF", 1);
+        check("\xE0\x9F\xBF", 0);
+        check("\xF0\x8F\xBF\xBF", 0);
+    }
+
+    void surrogates()
+    {
+        check("\xED\xA0\x80", 0); // U+D800
+        check("ab\xED\xBF\xBF", 2); // U+DFFF
+    }
+
+    void above_max()
+    {
+        check("\xF4\x90\x80\x80", 0); // U+110000
+        check("\xF5\x80\x80\x80", 0);
+        check("\xFF", 0);
+    }
+
+    void truncated()
+    {
+        check("\xC3", 0);
+        check("\xE2\x82", 0);
+        check("\xF0\x9F\x98", 0);
+        check("\xE2\x82x", 0);
+        check("\x80", 0); // Lone continuation byte
+    }
+
+    void control_characters()
+    {
+        check("a\tb", cli::utf8::NONE);
+        check("a\tb", 1, true);
+        check("\x7F", 0, true);
+
+        // C1 controls, U+0080 to U+009F
+        check("\xC2\x80", cli::utf8::NONE);
+        check("\xC2\x80", 0, true);
+        check("x\xC2\x9F", 1, true);
+        check("\xC2\xA0", cli::utf8::NONE, true); // U+00A0 is not a control
+    }
+
+    void parse_errors()
+    {
+        cli::app app("tool", "Does things", 1, no_args);
+        app.command("run", "r", "Runs", false);
+        app.flag("name", "n", "Name", Celery::Str::External("none"));
+        app.validate_utf8(true);
+
+        const std::string bad = std::string(20, 'x') + "\xED\xA0\x80";
+        const char *invalid[] = {"tool", "run", "-n", bad.c_str(), nullptr};
+        app.parse(4, invalid);
+        CHECK_ERROR(INVALID_UTF8);
+        CHECK(cli::global_error.argv_pos == 3);
+        CHECK(cli::global_error.offset == 20);
+
+        const char *control[] = {"tool", "run", "--name=a\x1b[0m", nullptr};
+        app.parse(3, control);
+        CHECK_ERROR(CONTROL_CHARACTER);
+        CHECK(cli::global_error.offset == 1);
+    }
+}
+
+int main()
+{
+    valid();
+    overlongs();
+    surrogates();
+    above_max();
+    truncated();
+    control_characters();
+    parse_errors();
+    return cli::test::result();
+}